@@ -34,6 +34,12 @@ public:
         this->ReadFromFile(filename);
     }
 
+    // Constructeur a partir d'un nom de fichier, lu par nbThreads threads
+    // (0 pour utiliser tous les coeurs)
+    GraphWeighted(const std::string& filename, unsigned nbThreads) {
+        this->ReadFromFileParallel(filename, nbThreads);
+    }
+
     // Constructeur a partie d'un stream
     GraphWeighted(std::istream
                   & s) {
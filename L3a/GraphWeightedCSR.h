@@ -0,0 +1,84 @@
+/*
+ * File:   GraphWeightedCSR.h
+ * Author: Berney Alec, Forestier Quentin, Herzig Melvyn
+ *
+ * Created on 17. octobre 2026
+ */
+
+#ifndef ASD2_GraphWeightedCSR_h
+#define ASD2_GraphWeightedCSR_h
+
+#include "GraphWeightedCSRCommon.h"
+#include "GraphWeighted.h"
+
+// Classe definissant un graphe pondere non-oriente immuable au format CSR.
+// Elle offre la meme interface de parcours que GraphWeighted et peut donc
+// etre passee telle quelle a MinimumSpanningTree.
+
+template<typename T> // Type du poids, par exemple int ou double
+class GraphWeightedCSR : public GraphWeightedCSRCommon<EdgeWeighted<T>> {
+// defini la class mere comme BASE.
+   typedef GraphWeightedCSRCommon<EdgeWeighted<T>> BASE;
+
+public:
+   // Type des arêtes.
+   typedef typename BASE::Edge Edge;
+
+   // Type de donnée pour les poids
+   typedef typename BASE::WeightType WeightType;
+
+   // Constructeur a partir d'un graphe a listes d'adjacence.
+   // Chaque arete y apparait dans les listes de ses deux sommets.
+   explicit GraphWeightedCSR(const GraphWeighted<T>& g) {
+      this->build(g, [] (int v, const Edge& e) { return e.Other(v); });
+   }
+
+   // Constructeur a partir d'un fichier binaire ecrit par Save. Le fichier
+   // est projete en memoire puis relu une fois pour etre verifie: l'arete
+   // rangee chez v doit avoir v pour extremite et son target pour autre
+   // extremite.
+   explicit GraphWeightedCSR(const std::string& binaryFilename) {
+      this->map(binaryFilename, false, [] (int v, const Edge& e, int w) {
+         int x = e.Either(), y = e.Other(x);
+         return (x == v && y == w) || (y == v && x == w);
+      });
+   }
+
+   // Ecrit le graphe au format binaire
+   void Save(const std::string& binaryFilename) const {
+      this->save(binaryFilename, false);
+   }
+
+   // Lit un fichier texte "V E" puis "v w weight" avec nbThreads threads
+   // (0 pour utiliser tous les coeurs), sans passer par GraphWeighted.
+   static GraphWeightedCSR FromText(const std::string& textFilename, unsigned nbThreads = 0) {
+      typename GraphTextParser<T>::Data data = GraphTextParser<T>::Parse(textFilename, nbThreads);
+      GraphWeightedCSR g;
+      g.buildFromEntries(data.V, data.edges, false);
+      return g;
+   }
+
+   // Convertit un fichier texte "V E" puis "v w weight" en fichier binaire
+   static void ConvertFromText(const std::string& textFilename, const std::string& binaryFilename) {
+      FromText(textFilename).Save(binaryFilename);
+   }
+
+private:
+   GraphWeightedCSR() {}
+
+public:
+
+   // Parcours de toutes les arêtes du graphe, dans le meme ordre que
+   // GraphWeighted::forEachEdge.
+   // la fonction f doit prendre un seul argument de type
+   // GraphWeightedCSR::Edge
+   template<typename Func>
+   void forEachEdge(Func f) const {
+      for (int v = 0; v < this->V(); ++v)
+         for (int i = this->offsets[v]; i < this->offsets[v + 1]; ++i)
+            if (this->targets[i] >= v)
+               f(this->edges[i]);
+   }
+};
+
+#endif
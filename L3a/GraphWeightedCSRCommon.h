@@ -0,0 +1,353 @@
+/*
+ * File:   GraphWeightedCSRCommon.h
+ * Author: Berney Alec, Forestier Quentin, Herzig Melvyn
+ *
+ * Created on 17. octobre 2026
+ */
+
+#ifndef ASD2_GraphWeightedCSRCommon_h
+#define ASD2_GraphWeightedCSRCommon_h
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "MappedFile.h"
+
+//  Classe regroupant toutes les parties communes de
+//  GraphWeightedCSR et GraphWeightedDirectedCSR.
+//
+//  Les listes d'adjacence sont stockées au format CSR (compressed sparse row):
+//  les arcs/arêtes adjacent-es au sommet v occupent les cases
+//  [offsets[v], offsets[v+1]) des tableaux contigus edges et targets.
+//  Le graphe est immuable une fois construit.
+//
+//  Les tableaux sont soit possédés par le graphe, soit lus directement dans
+//  un fichier binaire projeté en mémoire (voir Save et map). Format du
+//  fichier, en ordre d'octets natif:
+//    - CSRHeader
+//    - offsets : V+1 int32 à partir de header.offsetsPos
+//    - edges   : nbSlots Edge bruts à partir de header.edgesPos
+//    - targets : nbSlots int32 à partir de header.targetsPos
+//  Chaque section commence sur un multiple de 16 octets.
+
+// En-tête des fichiers binaires de graphes CSR.
+struct CSRHeader {
+   char     magic[8];     // "ASD2CSR" suivi d'un octet nul
+   uint32_t version;      // CSR_VERSION
+   uint32_t directed;     // 1 pour un graphe oriente, 0 sinon
+   uint32_t weightSize;   // sizeof(WeightType)
+   uint32_t edgeSize;     // sizeof(Edge)
+   int64_t  V;            // nombre de sommets
+   int64_t  nbSlots;      // nombre de cases des tableaux edges et targets
+   int64_t  offsetsPos;   // position de la section offsets dans le fichier
+   int64_t  edgesPos;     // position de la section edges
+   int64_t  targetsPos;   // position de la section targets
+};
+
+static const char CSR_MAGIC[8] = "ASD2CSR";
+static const uint32_t CSR_VERSION = 1;
+
+template<typename T>  // type des edges
+class GraphWeightedCSRCommon {
+public:
+   // Type des arcs/arêtes.
+   typedef T Edge;
+
+   // Type de donnée pour les poids
+   typedef typename Edge::WeightType WeightType;
+
+   static_assert(std::is_trivially_copyable<Edge>::value,
+                 "GraphWeightedCSRCommon : Edge doit etre copiable octet par octet");
+
+   GraphWeightedCSRCommon(const GraphWeightedCSRCommon&) = delete;
+   GraphWeightedCSRCommon& operator=(const GraphWeightedCSRCommon&) = delete;
+
+   // Le déplacement conserve les tampons des vecteurs, les vues restent valides.
+   GraphWeightedCSRCommon(GraphWeightedCSRCommon&&) = default;
+   GraphWeightedCSRCommon& operator=(GraphWeightedCSRCommon&&) = default;
+
+protected:
+   // Nombre de sommets
+   int nbVertices;
+
+   // offsets[v] est l'indice du premier arc/arête adjacent-e à v.
+   // offsets contient V+1 valeurs, la dernière vaut le nombre total de cases.
+   const int* offsets;
+
+   // Arcs/arêtes adjacent-es, regroupé-es par sommet.
+   const Edge* edges;
+
+   // targets[i] est le sommet atteint depuis le sommet courant par edges[i].
+   const int* targets;
+
+   // Stockage des tableaux lorsque le graphe est construit en mémoire.
+   std::vector<int> offsetStorage;
+   std::vector<Edge> edgeStorage;
+   std::vector<int> targetStorage;
+
+   // Fichier projeté lorsque le graphe est ouvert depuis un fichier binaire.
+   std::unique_ptr<MappedFile> mapping;
+
+   GraphWeightedCSRCommon() : nbVertices(0), offsetStorage(1, 0) {
+      attachStorage();
+   }
+
+   // Fait pointer les vues sur les tableaux possédés par le graphe.
+   void attachStorage() {
+      nbVertices = int(offsetStorage.size()) - 1;
+      offsets = offsetStorage.data();
+      edges   = edgeStorage.data();
+      targets = targetStorage.data();
+   }
+
+   /**
+    * @brief Construit la représentation CSR à partir d'un graphe à listes d'adjacence.
+    * @param g Graphe source, doit définir V() et forEachAdjacentEdge(int, Func).
+    * @param target Fonction (int v, const Edge& e) -> int renvoyant le sommet
+    *        atteint depuis v par e.
+    * @details L'ordre des arcs/arêtes adjacent-es à chaque sommet est conservé.
+    */
+   template<typename GraphType, typename TargetFunc>
+   void build(const GraphType& g, TargetFunc target)
+   {
+      offsetStorage.assign(g.V() + 1, 0);
+
+      for (int v = 0; v < g.V(); ++v)
+      {
+         int degree = 0;
+         g.forEachAdjacentEdge(v, [&degree] (const Edge&) { ++degree; });
+         offsetStorage[v + 1] = offsetStorage[v] + degree;
+      }
+
+      edgeStorage.clear();
+      edgeStorage.reserve(offsetStorage.back());
+      targetStorage.clear();
+      targetStorage.reserve(offsetStorage.back());
+
+      for (int v = 0; v < g.V(); ++v)
+      {
+         g.forEachAdjacentEdge(v, [&] (const Edge& e)
+         {
+            edgeStorage.push_back(e);
+            targetStorage.push_back(target(v, e));
+         });
+      }
+
+      attachStorage();
+   }
+
+   /**
+    * @brief Construit la représentation CSR à partir d'une liste d'arcs/arêtes
+    *        par un tri par dénombrement.
+    * @param nbV Nombre de sommets.
+    * @param entries Arcs/arêtes, définissant les membres v, w et weight.
+    * @param directed Si faux, chaque arête est aussi rangée chez w (sauf boucle).
+    * @details Un premier passage compte les degrés, un second range les arcs
+    *          à leur place. L'ordre de entries est conservé pour chaque sommet,
+    *          le résultat est donc le même que celui de build sur un graphe
+    *          rempli par addEdge dans cet ordre.
+    */
+   template<typename Entries>
+   void buildFromEntries(int nbV, const Entries& entries, bool directed)
+   {
+      offsetStorage.assign(nbV + 1, 0);
+      for (const auto& e : entries)
+      {
+         ++offsetStorage[e.v + 1];
+         if (!directed && e.v != e.w) ++offsetStorage[e.w + 1];
+      }
+      for (int v = 0; v < nbV; ++v)
+         offsetStorage[v + 1] += offsetStorage[v];
+
+      edgeStorage.resize(offsetStorage.back());
+      targetStorage.resize(offsetStorage.back());
+
+      std::vector<int> next(offsetStorage.begin(), offsetStorage.end() - 1);
+      for (const auto& e : entries)
+      {
+         int i = next[e.v]++;
+         edgeStorage[i] = Edge(e.v, e.w, e.weight);
+         targetStorage[i] = e.w;
+         if (!directed && e.v != e.w)
+         {
+            int j = next[e.w]++;
+            edgeStorage[j] = Edge(e.v, e.w, e.weight);
+            targetStorage[j] = e.v;
+         }
+      }
+
+      attachStorage();
+   }
+
+   /**
+    * @brief Ouvre un fichier écrit par Save en le projetant en mémoire.
+    * @param filename Nom du fichier binaire.
+    * @param directed Vrai si le fichier doit contenir un graphe orienté.
+    * @param connects Fonction (int v, const Edge& e, int w) -> bool indiquant
+    *        si e est bien l'arc/arête rangé-e chez v et menant à w.
+    * @throws std::runtime_error si le fichier est absent, tronqué, d'une autre
+    *         version, incompatible avec ce type de graphe, ou si ses offsets,
+    *         ses targets ou ses edges sont invalides.
+    * @details Aucune donnée n'est copiée, les vues pointent dans le fichier.
+    *          Les sections sont parcourues une fois pour vérifier que les
+    *          offsets ne décroissent pas, que chaque target est un sommet et
+    *          que chaque arc/arête relie le sommet de sa ligne à son target.
+    *          Les parcours peuvent ensuite suivre les extrémités des arcs sans
+    *          sortir du graphe. Les poids ne sont pas vérifiés.
+    */
+   template<typename ConnectsFunc>
+   void map(const std::string& filename, bool directed, ConnectsFunc connects)
+   {
+      mapping.reset(new MappedFile(filename));
+      const char* base = mapping->data();
+      size_t size = mapping->size();
+
+      CSRHeader h;
+      if (size < sizeof(h))
+         throw std::runtime_error("GraphWeightedCSR : fichier trop court " + filename);
+      std::memcpy(&h, base, sizeof(h));
+
+      if (std::memcmp(h.magic, CSR_MAGIC, sizeof(CSR_MAGIC)) != 0)
+         throw std::runtime_error("GraphWeightedCSR : format inconnu " + filename);
+      if (h.version != CSR_VERSION)
+         throw std::runtime_error("GraphWeightedCSR : version non supportee " + filename);
+      if (h.directed != uint32_t(directed) || h.weightSize != sizeof(WeightType) ||
+          h.edgeSize != sizeof(Edge))
+         throw std::runtime_error("GraphWeightedCSR : type de graphe incompatible " + filename);
+
+      // Les sommets et les cases sont numérotés par des int: les longueurs
+      // des sections tiennent alors largement dans un int64_t.
+      if (h.V < 0 || h.V >= std::numeric_limits<int>::max() ||
+          h.nbSlots < 0 || h.nbSlots > std::numeric_limits<int>::max())
+         throw std::runtime_error("GraphWeightedCSR : taille invalide " + filename);
+      if (!fits(h.offsetsPos, (h.V + 1) * int64_t(sizeof(int)), size) ||
+          !fits(h.edgesPos, h.nbSlots * int64_t(sizeof(Edge)), size) ||
+          !fits(h.targetsPos, h.nbSlots * int64_t(sizeof(int)), size))
+         throw std::runtime_error("GraphWeightedCSR : fichier tronque " + filename);
+      if (h.offsetsPos % 16 != 0 || h.edgesPos % 16 != 0 || h.targetsPos % 16 != 0)
+         throw std::runtime_error("GraphWeightedCSR : sections mal alignees " + filename);
+
+      offsetStorage.clear();
+      edgeStorage.clear();
+      targetStorage.clear();
+
+      nbVertices = int(h.V);
+      offsets = reinterpret_cast<const int*>(base + h.offsetsPos);
+      edges   = reinterpret_cast<const Edge*>(base + h.edgesPos);
+      targets = reinterpret_cast<const int*>(base + h.targetsPos);
+
+      if (offsets[0] != 0 || offsets[nbVertices] != h.nbSlots)
+         throw std::runtime_error("GraphWeightedCSR : section offsets invalide " + filename);
+
+      for (int v = 0; v < nbVertices; ++v)
+      {
+         if (offsets[v + 1] < offsets[v])
+            throw std::runtime_error("GraphWeightedCSR : section offsets invalide " + filename);
+         for (int i = offsets[v]; i < offsets[v + 1]; ++i)
+         {
+            if (targets[i] < 0 || targets[i] >= nbVertices)
+               throw std::runtime_error("GraphWeightedCSR : section targets invalide " + filename);
+            if (!connects(v, edges[i], targets[i]))
+               throw std::runtime_error("GraphWeightedCSR : section edges invalide " + filename);
+         }
+      }
+   }
+
+   /**
+    * @brief Ecrit le graphe dans un fichier binaire lisible par map.
+    * @param filename Nom du fichier à écrire.
+    * @param directed Vrai si le graphe est orienté.
+    */
+   void save(const std::string& filename, bool directed) const
+   {
+      std::ofstream s(filename, std::ios::binary);
+      if (!s)
+         throw std::runtime_error("GraphWeightedCSR : impossible d'ecrire " + filename);
+
+      int64_t nbSlots = offsets[nbVertices];
+
+      CSRHeader h;
+      std::memset(&h, 0, sizeof(h));
+      std::memcpy(h.magic, CSR_MAGIC, sizeof(CSR_MAGIC));
+      h.version    = CSR_VERSION;
+      h.directed   = directed;
+      h.weightSize = sizeof(WeightType);
+      h.edgeSize   = sizeof(Edge);
+      h.V          = nbVertices;
+      h.nbSlots    = nbSlots;
+      h.offsetsPos = align(sizeof(h));
+      h.edgesPos   = align(h.offsetsPos + (h.V + 1) * sizeof(int));
+      h.targetsPos = align(h.edgesPos + nbSlots * sizeof(Edge));
+
+      int64_t pos = 0;
+      writeSection(s, pos, 0, &h, sizeof(h));
+      writeSection(s, pos, h.offsetsPos, offsets, (h.V + 1) * sizeof(int));
+      writeSection(s, pos, h.edgesPos, edges, nbSlots * sizeof(Edge));
+      writeSection(s, pos, h.targetsPos, targets, nbSlots * sizeof(int));
+
+      if (!s)
+         throw std::runtime_error("GraphWeightedCSR : erreur d'ecriture " + filename);
+   }
+
+private:
+
+   // Indique si la section [pos, pos + length) est contenue dans un fichier de size octets
+   static bool fits(int64_t pos, int64_t length, size_t size) {
+      return pos >= 0 && pos <= int64_t(size) && length <= int64_t(size) - pos;
+   }
+
+   // Arrondit pos au multiple de 16 supérieur
+   static int64_t align(int64_t pos) {
+      return (pos + 15) & ~int64_t(15);
+   }
+
+   // Complète le fichier avec des zéros jusqu'à start puis écrit la section.
+   static void writeSection(std::ofstream& s, int64_t& pos, int64_t start,
+                            const void* data, int64_t length) {
+      static const char zeros[16] = {};
+      s.write(zeros, start - pos);
+      s.write(static_cast<const char*>(data), length);
+      pos = start + length;
+   }
+
+public:
+
+   // Renvoie le nombre de sommets V
+   int V() const {
+      return nbVertices;
+   }
+
+   // Parcours des arcs/arêtes adjacentes au sommet v.
+   // la fonction f doit prendre un seul argument de type
+   // GraphWeightedCSRCommon::Edge
+   template<typename Func>
+   void forEachAdjacentEdge(int v, Func f) const {
+      for (int i = offsets[v]; i < offsets[v + 1]; ++i)
+         f(edges[i]);
+   }
+
+   // Parcours de tous les sommets adjacents au sommet v
+   // la fonction f doit prendre un seul argument de type int
+   template<typename Func>
+   void forEachAdjacentVertex(int v, Func f) const {
+      for (int i = offsets[v]; i < offsets[v + 1]; ++i)
+         f(targets[i]);
+   }
+
+   // Parcours de tous les sommets du graphe.
+   // la fonction f doit prendre un seul argument de type int
+   template<typename Func>
+   void forEachVertex(Func f) const {
+      for (int v = 0; v < V(); ++v)
+         f(v);
+   }
+};
+
+#endif
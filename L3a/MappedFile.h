@@ -0,0 +1,95 @@
+/*
+ * File:   MappedFile.h
+ * Author: Berney Alec, Forestier Quentin, Herzig Melvyn
+ *
+ * Created on 17. octobre 2026
+ */
+
+#ifndef ASD2_MappedFile_h
+#define ASD2_MappedFile_h
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//  Fichier projeté en mémoire en lecture seule. Sur les systèmes POSIX le
+//  contenu est accédé via mmap et n'est chargé qu'à la demande par le noyau.
+//  Ailleurs, le fichier est lu d'un bloc dans un tampon.
+
+class MappedFile {
+private:
+   const char* bytes;
+   size_t length;
+
+#ifdef _WIN32
+   // Tampon aligné sur 8 octets contenant tout le fichier.
+   std::vector<long long> buffer;
+#endif
+
+public:
+
+   // Ouvre et projette le fichier filename. Lance std::runtime_error en cas d'échec.
+   explicit MappedFile(const std::string& filename) : bytes(nullptr), length(0) {
+#ifdef _WIN32
+      std::ifstream s(filename, std::ios::binary | std::ios::ate);
+      if (!s)
+         throw std::runtime_error("MappedFile : impossible d'ouvrir " + filename);
+      length = size_t(s.tellg());
+      buffer.resize((length + sizeof(long long) - 1) / sizeof(long long));
+      s.seekg(0);
+      s.read(reinterpret_cast<char*>(buffer.data()), length);
+      bytes = reinterpret_cast<const char*>(buffer.data());
+#else
+      int fd = open(filename.c_str(), O_RDONLY);
+      if (fd == -1)
+         throw std::runtime_error("MappedFile : impossible d'ouvrir " + filename);
+
+      struct stat st;
+      if (fstat(fd, &st) == -1) {
+         close(fd);
+         throw std::runtime_error("MappedFile : impossible de lire la taille de " + filename);
+      }
+      length = size_t(st.st_size);
+
+      if (length > 0) {
+         void* p = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+         if (p == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("MappedFile : mmap a echoue pour " + filename);
+         }
+         bytes = static_cast<const char*>(p);
+      }
+      close(fd);    // la projection reste valide après la fermeture
+#endif
+   }
+
+   MappedFile(const MappedFile&) = delete;
+   MappedFile& operator=(const MappedFile&) = delete;
+
+   ~MappedFile() {
+#ifndef _WIN32
+      if (bytes != nullptr)
+         munmap(const_cast<char*>(bytes), length);
+#endif
+   }
+
+   // Début du contenu du fichier
+   const char* data() const {
+      return bytes;
+   }
+
+   // Taille du fichier en octets
+   size_t size() const {
+      return length;
+   }
+};
+
+#endif
@@ -13,8 +13,12 @@
 #include <vector>
 #include <set>
 #include <functional>
+#include <atomic>
+#include <cmath>
+#include <algorithm>
 
 #include "UnionFind.h"
+#include "Parallel.h"
 
 // Classe définissant les différents algorithmes de calcul de l'arbre
 // couvrant de poids minimum sous forme de methodes statiques.
@@ -145,8 +149,221 @@ public:
        return mst;
     }
 
+    /**
+     * @Brief Algorithme de Kruskal. Implemente avec UnionFind.
+     * @param g Graphe sur lequel appliquer Kruskal.
+     * @param nbThreads Nombre de threads pour le tri des arêtes, 0 pour utiliser
+     *        tous les coeurs.
+     * @return Vecteur des arrête du minimum spanning tree.
+     */
+    static EdgeList Kruskal(const GraphType& g, unsigned nbThreads = 0)
+    {
+       EdgeList edges;
+       g.forEachEdge([&](const Edge& e){ edges.push_back(e); });
+
+       parallelSort(edges.begin(), edges.end(), std::less<Edge>(), nbThreads);
+
+       EdgeList mst;
+       mst.reserve(g.V() - 1);
+       UnionFind uf = {g.V()};
+
+       kruskal(edges.begin(), edges.end(), uf, mst, g.V());
+
+       return mst;
+    }
+
+    /**
+     * @Brief Algorithme Filter-Kruskal. Implemente avec UnionFind.
+     * @param g Graphe sur lequel appliquer Filter-Kruskal.
+     * @param nbThreads Nombre de threads pour le tri des arêtes, 0 pour utiliser
+     *        tous les coeurs.
+     * @return Vecteur des arrête du minimum spanning tree.
+     * @details Les arêtes sont partitionnées autour d'un pivot. La moitié légère
+     *          est traitée récursivement, puis les arêtes de la moitié lourde
+     *          dont les deux extrémités sont déjà reliées sont écartées avant
+     *          de traiter le reste. Sur un graphe dense, la plupart des arêtes
+     *          lourdes ne sont ainsi jamais triées.
+     */
+    static EdgeList FilterKruskal(const GraphType& g, unsigned nbThreads = 0)
+    {
+       EdgeList edges;
+       g.forEachEdge([&](const Edge& e){ edges.push_back(e); });
+
+       EdgeList mst;
+       mst.reserve(g.V() - 1);
+       UnionFind uf = {g.V()};
+
+       filterKruskal(edges.begin(), edges.end(), uf, mst, g.V(), threadCount(nbThreads));
+
+       return mst;
+    }
+
+    /**
+     * @Brief Algorithme de Boruvka multi-thread. Implemente avec ConcurrentUnionFind.
+     * @param g Graphe sur lequel appliquer Boruvka.
+     * @param nbThreads Nombre de threads, 0 pour utiliser tous les coeurs.
+     * @return Vecteur des arrête du minimum spanning tree.
+     * @details A chaque tour, les arêtes sont réparties en tranches, une par thread.
+     *          Chaque thread retire de sa tranche les arêtes devenues internes à
+     *          une composante et propose les autres aux composantes de leurs
+     *          extrémités. plusProches[c] contient l'indice de l'arête la plus
+     *          légère sortant de la composante c et est mis à jour par
+     *          compare-and-swap. Les égalités de poids sont départagées par
+     *          l'indice de l'arête, ce qui garantit qu'aucun cycle n'est ajouté.
+     */
+    static EdgeList BoruvkaParallel(const GraphType& g, unsigned nbThreads = 0)
+    {
+       nbThreads = threadCount(nbThreads);
+
+       EdgeList edges;
+       g.forEachEdge([&](const Edge& e){ edges.push_back(e); });
+       int E = int(edges.size());
+
+       ConcurrentUnionFind uf = {g.V()};
+
+       std::vector<std::atomic<int>> plusProches(g.V());
+       for (std::atomic<int>& slot : plusProches)
+          slot.store(-1);
+
+       // Tranche [debut[t], debut[t] + restantes[t]) des arêtes encore utiles au thread t.
+       std::vector<int> debut(nbThreads), restantes(nbThreads);
+       for (unsigned t = 0; t < nbThreads; ++t)
+       {
+          debut[t]     = int((long long) E * t / nbThreads);
+          restantes[t] = int((long long) E * (t + 1) / nbThreads) - debut[t];
+       }
+
+       std::vector<EdgeList> ajoutees(nbThreads);
+
+       auto plusLegere = [&](int a, int b) {
+          return edges[a] < edges[b] || (!(edges[b] < edges[a]) && a < b);
+       };
+
+       auto proposer = [&](int c, int i) {
+          int courante = plusProches[c].load();
+          while ((courante == -1 || plusLegere(i, courante)) &&
+                 !plusProches[c].compare_exchange_weak(courante, i));
+       };
+
+       bool fusion = true;
+       while (fusion)
+       {
+          parallelFor(nbThreads, int(nbThreads), [&](unsigned, int tBegin, int tEnd) {
+             for (int t = tBegin; t < tEnd; ++t)
+             {
+                int out = debut[t];
+                for (int i = debut[t]; i < debut[t] + restantes[t]; ++i)
+                {
+                   Edge e = edges[i];
+                   int v = e.Either();
+                   int a = uf.Find(v);
+                   int b = uf.Find(e.Other(v));
+
+                   if (a != b)
+                   {
+                      edges[out] = e;
+                      proposer(a, out);
+                      proposer(b, out);
+                      ++out;
+                   }
+                }
+                restantes[t] = out - debut[t];
+             }
+          });
+
+          std::atomic<bool> fusionTour(false);
+
+          parallelFor(nbThreads, g.V(), [&](unsigned t, int vBegin, int vEnd) {
+             for (int c = vBegin; c < vEnd; ++c)
+             {
+                int i = plusProches[c].load();
+                if (i == -1) continue;
+                plusProches[c].store(-1);
+
+                const Edge& e = edges[i];
+                int v = e.Either();
+                if (uf.Union(v, e.Other(v)))
+                {
+                   ajoutees[t].push_back(e);
+                   fusionTour.store(true);
+                }
+             }
+          });
+
+          fusion = fusionTour.load();
+       }
+
+       EdgeList mst;
+       mst.reserve(g.V() - 1);
+       for (const EdgeList& l : ajoutees)
+          mst.insert(mst.end(), l.begin(), l.end());
+
+       return mst;
+    }
+
 private:
 
+   typedef typename EdgeList::iterator EdgeIterator;
+
+   /**
+    * @Brief Ajoute à mst les arêtes de [begin, end), triées par poids croissant,
+    *        qui relient deux composantes distinctes.
+    * @details S'arrête dès que mst contient V-1 arêtes.
+    */
+   static void kruskal(EdgeIterator begin, EdgeIterator end, UnionFind& uf, EdgeList& mst, int V)
+   {
+      for (EdgeIterator it = begin; it != end && int(mst.size()) < V - 1; ++it)
+      {
+         int v = it->Either();
+         int w = it->Other(v);
+         if (!uf.Connected(v, w))
+         {
+            uf.Union(v, w);
+            mst.push_back(*it);
+         }
+      }
+   }
+
+   /**
+    * @Brief Etape récursive de Filter-Kruskal sur les arêtes [begin, end).
+    * @details En dessous de V arêtes, le coût du partitionnement n'est plus
+    *          rentable et on revient à Kruskal.
+    */
+   static void filterKruskal(EdgeIterator begin, EdgeIterator end, UnionFind& uf,
+                             EdgeList& mst, int V, unsigned nbThreads)
+   {
+      if (begin == end || int(mst.size()) >= V - 1) return;
+
+      if (end - begin <= V)
+      {
+         parallelSort(begin, end, std::less<Edge>(), nbThreads);
+         kruskal(begin, end, uf, mst, V);
+         return;
+      }
+
+      // pivot: médiane du premier, du milieu et du dernier poids
+      Edge a = *begin, b = *(begin + (end - begin) / 2), c = *(end - 1);
+      Edge pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+      EdgeIterator middle = std::partition(begin, end, [&](const Edge& e){ return e < pivot; });
+      if (middle == begin)       // le pivot est le plus petit poids
+         middle = std::partition(begin, end, [&](const Edge& e){ return !(pivot < e); });
+      if (middle == end)         // tous les poids sont égaux
+      {
+         kruskal(begin, end, uf, mst, V);
+         return;
+      }
+
+      filterKruskal(begin, middle, uf, mst, V, nbThreads);
+
+      middle = std::partition(middle, end, [&](const Edge& e){
+         int v = e.Either();
+         return uf.Connected(v, e.Other(v));
+      });
+
+      filterKruskal(middle, end, uf, mst, V, nbThreads);
+   }
+
    /**
     * @Brief Compare si deux arrête pondérées sont égales.
     * @param e1 Première arrête.
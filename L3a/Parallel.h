@@ -0,0 +1,104 @@
+/*
+ * File:   Parallel.h
+ * Author: Berney Alec, Forestier Quentin, Herzig Melvyn
+ *
+ * Created on 17. octobre 2026
+ */
+
+#ifndef ASD2_Parallel_h
+#define ASD2_Parallel_h
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Renvoie le nombre de threads à utiliser.
+ * @param nbThreads Nombre demandé, 0 pour laisser choisir la machine.
+ * @return nbThreads s'il est non nul, sinon le nombre de coeurs (au moins 1).
+ */
+inline unsigned threadCount (unsigned nbThreads = 0)
+{
+   if (nbThreads != 0) return nbThreads;
+   return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Découpe [0, n) en nbThreads tranches contiguës et applique f à chacune
+ *        dans son propre thread.
+ * @param nbThreads Nombre de tranches (et de threads).
+ * @param n Taille de l'intervalle à découper.
+ * @param f Fonction (unsigned t, int begin, int end) appelée pour la tranche t.
+ * @details La tranche 0 est traitée par le thread appelant. Lorsque
+ *          nbThreads vaut 1, aucun thread n'est créé.
+ */
+template<typename Func>
+void parallelFor (unsigned nbThreads, int n, Func f)
+{
+   std::vector<std::thread> workers;
+   workers.reserve(nbThreads - 1);
+
+   for (unsigned t = 1; t < nbThreads; ++t)
+   {
+      int begin = int((long long) n * t / nbThreads);
+      int end   = int((long long) n * (t + 1) / nbThreads);
+      workers.emplace_back([=, &f] { f(t, begin, end); });
+   }
+
+   f(0u, 0, int((long long) n / nbThreads));
+
+   for (std::thread& w : workers)
+      w.join();
+}
+
+/**
+ * @brief Trie [begin, end) selon comp avec nbThreads threads.
+ * @param begin, end Itérateurs à accès direct délimitant la séquence.
+ * @param comp Relation d'ordre strict.
+ * @param nbThreads Nombre de threads, 0 pour utiliser tous les coeurs.
+ * @details La séquence est découpée en nbThreads tranches triées chacune par
+ *          std::sort dans son propre thread, puis les tranches voisines sont
+ *          fusionnées deux à deux (std::inplace_merge), les fusions d'un même
+ *          niveau s'exécutant en parallèle. Le tri n'est pas stable.
+ */
+template<typename RandomIt, typename Compare>
+void parallelSort (RandomIt begin, RandomIt end, Compare comp, unsigned nbThreads = 0)
+{
+   nbThreads = threadCount(nbThreads);
+   int n = int(end - begin);
+
+   // en dessous, créer des threads coûte plus que le tri lui-même
+   if (nbThreads == 1 || n < 4096)
+   {
+      std::sort(begin, end, comp);
+      return;
+   }
+
+   std::vector<int> bounds(nbThreads + 1);
+   for (unsigned t = 0; t <= nbThreads; ++t)
+      bounds[t] = int((long long) n * t / nbThreads);
+
+   parallelFor(nbThreads, int(nbThreads), [&] (unsigned, int tBegin, int tEnd)
+   {
+      for (int t = tBegin; t < tEnd; ++t)
+         std::sort(begin + bounds[t], begin + bounds[t + 1], comp);
+   });
+
+   for (unsigned width = 1; width < nbThreads; width *= 2)
+   {
+      int nbMerges = int((nbThreads + 2 * width - 1) / (2 * width));
+      parallelFor(unsigned(nbMerges), nbMerges, [&] (unsigned, int mBegin, int mEnd)
+      {
+         for (int m = mBegin; m < mEnd; ++m)
+         {
+            unsigned first = 2 * width * m;
+            unsigned middle = std::min(first + width, nbThreads);
+            unsigned last = std::min(first + 2 * width, nbThreads);
+            std::inplace_merge(begin + bounds[first], begin + bounds[middle],
+                               begin + bounds[last], comp);
+         }
+      });
+   }
+}
+
+#endif
@@ -9,6 +9,8 @@
 #define ASD2_UnionFind_h
 
 #include <vector>
+#include <atomic>
+#include <utility>
 
 //  Cette classe met en oeuvre de la structure Union-Find, aussi connue
 //  sous le nom de disjoint sets. Utilisé par l'algorithme de
@@ -59,4 +61,56 @@ public:
     }
 };
 
+//  Variante de UnionFind utilisable simultanément par plusieurs threads,
+//  sans verrou. Les mises à jour de id se font par compare-and-swap. Une
+//  racine est toujours rattachée à une racine d'indice plus grand, ce qui
+//  empêche la formation de cycles entre Union concurrents.
+
+class ConcurrentUnionFind {
+private:
+    // id[i] stocke l'id du parent de i dans l'arbre des classes d'équivalence
+    std::vector<std::atomic<int>> id;
+
+public:
+
+    // Constructeur: spécifie le nombre N d'éléments
+    ConcurrentUnionFind(int N) : id(N) {
+        for (int i = 0; i < N; ++i)
+            id[i].store(i, std::memory_order_relaxed);
+    }
+
+    // Find renvoie l'id représentatif de la classe d'équivalence de p.
+    int Find(int p) {
+        while (true) {
+            int parent = id[p].load();
+            if (parent == p)
+                return p;
+            int grandParent = id[parent].load();
+            if (parent != grandParent)   // compression de chemin par dédoublement
+                id[p].compare_exchange_weak(parent, grandParent);
+            p = grandParent;
+        }
+    }
+
+    // Connected indique que p et q appartiennent à la même classe d'équivalence
+    bool Connected(int p, int q) {
+        return Find(p) == Find(q);
+    }
+
+    // Union fusionne les classes d'équivalence de p et q. Renvoie vrai si
+    // c'est cet appel qui a effectué la fusion, faux si p et q étaient déjà
+    // dans la même classe.
+    bool Union(int p, int q) {
+        while (true) {
+            int i = Find(p);
+            int j = Find(q);
+            if (i == j) return false;
+            if (i > j) std::swap(i, j);
+            int expected = i;           // échoue si i n'est plus une racine
+            if (id[i].compare_exchange_strong(expected, j))
+                return true;
+        }
+    }
+};
+
 #endif
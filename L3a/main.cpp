@@ -7,15 +7,105 @@
  */
 
 #include <cstdlib>
+#include <cstdio>
 #include <cmath>
 #include <iostream>
 #include <algorithm>
+#include <fstream>
+#include <stdexcept>
 
 #include "GraphWeighted.h"
+#include "GraphWeightedCSR.h"
 #include "MinimumSpanningTree.h"
 
 using namespace std;
 
+/**
+ * @brief Compare deux graphes non-orientés arête par arête.
+ * @return Vrai si a et b ont le même nombre de sommets, les mêmes arêtes dans
+ *         le même ordre et les mêmes sommets adjacents à chaque sommet.
+ */
+template<typename GraphA, typename GraphB>
+bool memeGraphe(const GraphA& a, const GraphB& b) {
+    if (a.V() != b.V())
+    {
+       return false;
+    }
+
+    vector<typename GraphA::Edge> edgesA;
+    vector<typename GraphB::Edge> edgesB;
+    a.forEachEdge([&](const typename GraphA::Edge& e) { edgesA.push_back(e); });
+    b.forEachEdge([&](const typename GraphB::Edge& e) { edgesB.push_back(e); });
+
+    if (edgesA.size() != edgesB.size())
+    {
+       return false;
+    }
+
+    for(size_t i = 0; i < edgesA.size(); ++i)
+    {
+       int v = edgesA[i].Either();
+       if (v != edgesB[i].Either() || edgesA[i].Other(v) != edgesB[i].Other(v) ||
+           fabs(edgesA[i].Weight() - edgesB[i].Weight()) > 0.000000001)
+       {
+          return false;
+       }
+    }
+
+    for(int v = 0; v < a.V(); ++v)
+    {
+       vector<int> adjA, adjB;
+       a.forEachAdjacentVertex(v, [&](int w) { adjA.push_back(w); });
+       b.forEachAdjacentVertex(v, [&](int w) { adjB.push_back(w); });
+       if (adjA != adjB)
+       {
+          return false;
+       }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Vérifie que les lecteurs multi-thread refusent les fichiers dont un
+ *        sommet est hors de [0, V) ou ne tient pas dans un int.
+ * @return Retourne vrai si chaque fichier invalide lève std::runtime_error.
+ */
+bool testFichiersInvalides() {
+    typedef GraphWeighted<double> Graph;
+    typedef GraphWeightedCSR<double> GraphCSR;
+
+    const string fichier = "graphe_invalide.txt";
+    const string contenus[] = {
+       "3 1\n1 7 0.25\n",
+       "3 1\n-1 2 0.25\n",
+       "3 1\n1 4294967297 0.25\n"
+    };
+
+    bool ok = true;
+    for(const string& contenu : contenus)
+    {
+       ofstream(fichier) << contenu;
+
+       try
+       {
+          GraphCSR::FromText(fichier, 2);
+          ok = false;
+       }
+       catch(const runtime_error&) {}
+
+       try
+       {
+          Graph ewd(fichier, 2);
+          ok = false;
+       }
+       catch(const runtime_error&) {}
+    }
+    remove(fichier.c_str());
+
+    return ok;
+}
+
 /**
  * @brief Test si les MST issu du graphe de filename est correct en comparant deux algorithmes.
  * @param filename Nom du fichier contenant le graphe.
@@ -79,6 +169,84 @@ bool testMST(const string& filename) {
     cout << "3. Poids total du MST de Prim : " << totalWeightPrim << endl;
     cout << "   Poids total du MST de Boruvka : " << totalWeightBoruvka << endl;
 
+    // Quatrième condition, Boruvka donne le même poids sur la représentation CSR.
+    typedef GraphWeightedCSR<double> GraphCSR;
+    GraphCSR csr(ewd);
+
+    double totalWeightCSR = 0;
+    for(const GraphCSR::Edge& edge : MinimumSpanningTree<GraphCSR>::BoruvkaUnionFind(csr))
+    {
+       totalWeightCSR += edge.Weight();
+    }
+
+    if(fabs(totalWeightCSR - totalWeightPrim) > 0.000000001)
+    {
+       return false;
+    }
+
+    cout << "4. Poids total du MST de Boruvka (CSR) : " << totalWeightCSR << endl;
+
+    // Cinquième condition, Boruvka multi-thread donne le même poids que Prim.
+    MinimumSpanningTree<Graph>::EdgeList parallel = MinimumSpanningTree<Graph>::BoruvkaParallel(ewd);
+
+    double totalWeightParallel = 0;
+    for(const Graph::Edge& edge : parallel)
+    {
+       totalWeightParallel += edge.Weight();
+    }
+
+    if(parallel.size() != size_t(ewd.V() - 1) || fabs(totalWeightParallel - totalWeightPrim) > 0.000000001)
+    {
+       return false;
+    }
+
+    cout << "5. Poids total du MST de Boruvka multi-thread : " << totalWeightParallel << endl;
+
+    // Sixième condition, Kruskal et Filter-Kruskal donnent le même poids que Prim.
+    MinimumSpanningTree<Graph>::EdgeList kruskal = MinimumSpanningTree<Graph>::Kruskal(ewd);
+    MinimumSpanningTree<Graph>::EdgeList filterKruskal = MinimumSpanningTree<Graph>::FilterKruskal(ewd);
+
+    double totalWeightKruskal = 0;
+    for(const Graph::Edge& edge : kruskal)
+    {
+       totalWeightKruskal += edge.Weight();
+    }
+
+    double totalWeightFilterKruskal = 0;
+    for(const Graph::Edge& edge : filterKruskal)
+    {
+       totalWeightFilterKruskal += edge.Weight();
+    }
+
+    if(kruskal.size() != size_t(ewd.V() - 1) || filterKruskal.size() != size_t(ewd.V() - 1) ||
+       fabs(totalWeightKruskal - totalWeightPrim) > 0.000000001 ||
+       fabs(totalWeightFilterKruskal - totalWeightPrim) > 0.000000001)
+    {
+       return false;
+    }
+
+    cout << "6. Poids total du MST de Kruskal : " << totalWeightKruskal << endl;
+    cout << "   Poids total du MST de Filter-Kruskal : " << totalWeightFilterKruskal << endl;
+
+    // Septième condition, les lectures parallèles et les fichiers binaires
+    // redonnent le même graphe.
+    const string binaire = "graphe_test.bin";
+
+    csr.Save(binaire);
+    bool relu = memeGraphe(csr, GraphCSR(binaire));
+
+    GraphCSR::ConvertFromText(filename, binaire);
+    bool converti = memeGraphe(csr, GraphCSR(binaire));
+    remove(binaire.c_str());
+
+    if(!relu || !converti || !memeGraphe(csr, GraphCSR::FromText(filename, 4)) ||
+       !memeGraphe(ewd, Graph(filename, 4)))
+    {
+       return false;
+    }
+
+    cout << "7. Graphe identique apres Save/map, ConvertFromText et lecture multi-thread" << endl;
+
     return true;
 }
 
@@ -92,9 +260,15 @@ int main(int argc, const char* argv[]) {
         return EXIT_FAILURE;
     }
 
+    if (testFichiersInvalides()) {
+        cout << "Les fichiers invalides sont refuses" << endl << endl;
+    } else {
+        cout << "Un fichier invalide a ete accepte" << endl << endl;
+    }
+
     for (int i = 1; i < argc; ++i) {
         if (testMST(argv[i])) {
-            cout << "Les trois tests ont reussi" << endl << endl;
+            cout << "Tous les tests ont reussi" << endl << endl;
         } else {
             cout << "L'un des tests a echoue" << endl << endl;
         }
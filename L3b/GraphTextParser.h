@@ -0,0 +1,177 @@
+/*
+ * File:   GraphTextParser.h
+ * Author: Berney Alec, Forestier Quentin, Herzig Melvyn
+ *
+ * Created on 17. octobre 2026
+ */
+
+#ifndef ASD2_GraphTextParser_h
+#define ASD2_GraphTextParser_h
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "MappedFile.h"
+#include "Parallel.h"
+
+// Lecture multi-thread des fichiers texte de graphes au format
+//    V E
+//    v w weight   (E lignes)
+// Le fichier est projeté en mémoire puis découpé en tranches commençant en
+// début de ligne, une par thread. Chaque thread analyse sa tranche sans
+// allocation par champ et remplit son propre tampon d'arcs. Les tampons sont
+// ensuite concaténés dans l'ordre du fichier.
+
+template<typename T> // Type du poids, par exemple int ou double
+class GraphTextParser {
+public:
+   // Type de donnée pour les poids
+   typedef T WeightType;
+
+   // Arc/arête lu-e dans le fichier
+   struct Entry {
+      int v, w;
+      WeightType weight;
+   };
+
+   // Contenu d'un fichier: nombre de sommets et arcs/arêtes dans l'ordre du fichier
+   struct Data {
+      int V;
+      std::vector<Entry> edges;
+   };
+
+   /**
+    * @brief Lit le fichier filename.
+    * @param filename Nom du fichier texte.
+    * @param nbThreads Nombre de threads, 0 pour utiliser tous les coeurs.
+    * @return Nombre de sommets et les E premiers arcs/arêtes du fichier.
+    * @throws std::runtime_error si le fichier est illisible, contient moins
+    *         de E arcs/arêtes ou un sommet hors de [0, V).
+    * @details Chaque arc/arête doit tenir sur une seule ligne.
+    */
+   static Data Parse(const std::string& filename, unsigned nbThreads = 0)
+   {
+      MappedFile file(filename);
+      const char* p   = file.data();
+      const char* end = p + file.size();
+
+      Data data;
+      int E;
+      if (!parse(p, end, data.V) || !parse(p, end, E) || data.V < 0 || E < 0)
+         throw std::runtime_error("GraphTextParser : en-tete invalide dans " + filename);
+
+      nbThreads = threadCount(nbThreads);
+      std::vector<const char*> starts(nbThreads + 1);
+      starts[0] = p;
+      starts[nbThreads] = end;
+      for (unsigned t = 1; t < nbThreads; ++t)
+         starts[t] = lineStart(std::max(starts[t - 1], p + (end - p) * t / nbThreads), end);
+
+      std::vector<std::vector<Entry>> buffers(nbThreads);
+      std::vector<bool> valid(nbThreads, true);
+
+      parallelFor(nbThreads, int(nbThreads), [&] (unsigned, int tBegin, int tEnd)
+      {
+         for (int t = tBegin; t < tEnd; ++t)
+         {
+            const char* q = starts[t];
+            const char* stop = starts[t + 1];
+            // estimation grossière: une vingtaine d'octets par ligne
+            buffers[t].reserve((stop - q) / 16 + 1);
+
+            Entry e;
+            while (skipSpaces(q, stop) != stop)
+            {
+               if (!parse(q, stop, e.v) || !parse(q, stop, e.w) || !parse(q, stop, e.weight) ||
+                   e.v < 0 || e.v >= data.V || e.w < 0 || e.w >= data.V)
+               {
+                  valid[t] = false;
+                  break;
+               }
+               buffers[t].push_back(e);
+            }
+         }
+      });
+
+      size_t total = 0;
+      for (unsigned t = 0; t < nbThreads; ++t)
+      {
+         total += buffers[t].size();
+         if (!valid[t] && total < size_t(E))
+            throw std::runtime_error("GraphTextParser : ligne invalide dans " + filename);
+      }
+      if (total < size_t(E))
+         throw std::runtime_error("GraphTextParser : arcs manquants dans " + filename);
+
+      data.edges.reserve(E);
+      for (unsigned t = 0; t < nbThreads && data.edges.size() < size_t(E); ++t)
+      {
+         size_t n = std::min(buffers[t].size(), size_t(E) - data.edges.size());
+         data.edges.insert(data.edges.end(), buffers[t].begin(), buffers[t].begin() + n);
+         std::vector<Entry>().swap(buffers[t]);
+      }
+
+      return data;
+   }
+
+private:
+
+   static bool isSpace(char c) {
+      return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+   }
+
+   // Avance p jusqu'au premier caractère qui n'est pas un blanc
+   static const char* skipSpaces(const char*& p, const char* end) {
+      while (p != end && isSpace(*p)) ++p;
+      return p;
+   }
+
+   // Renvoie le début de la ligne suivant p (ou p s'il est déjà en début de ligne)
+   static const char* lineStart(const char* p, const char* end) {
+      if (p == end || p[-1] == '\n') return p;
+      const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+      return nl == nullptr ? end : nl + 1;
+   }
+
+   // Lecture d'un entier, sans passer par la locale. Echoue si la valeur ne
+   // tient pas dans un int.
+   static bool parse(const char*& p, const char* end, int& value) {
+      skipSpaces(p, end);
+      bool negative = p != end && *p == '-';
+      if (p != end && (*p == '-' || *p == '+')) ++p;
+      if (p == end || *p < '0' || *p > '9') return false;
+
+      const long long limit = static_cast<long long>(std::numeric_limits<int>::max()) + (negative ? 1 : 0);
+      long long v = 0;
+      while (p != end && *p >= '0' && *p <= '9')
+      {
+         v = v * 10 + (*p++ - '0');
+         if (v > limit) return false;
+      }
+      value = int(negative ? -v : v);
+      return p == end || isSpace(*p);
+   }
+
+   // Lecture d'un réel. Le champ est recopié dans un tampon local terminé par
+   // un zéro pour strtod, qui arrondit exactement comme operator>>.
+   static bool parse(const char*& p, const char* end, double& value) {
+      skipSpaces(p, end);
+      char buffer[64];
+      size_t n = 0;
+      while (p != end && !isSpace(*p) && n < sizeof(buffer) - 1)
+         buffer[n++] = *p++;
+      if (n == 0 || (p != end && !isSpace(*p))) return false;
+      buffer[n] = '\0';
+
+      char* last;
+      value = std::strtod(buffer, &last);
+      return last == buffer + n;
+   }
+};
+
+#endif
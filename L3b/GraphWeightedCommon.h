@@ -15,6 +15,8 @@
 #include <limits>
 #include <fstream>
 
+#include "GraphTextParser.h"
+
 //  Classe regroupant toutes les parties communes de
 //  GraphWeighted et GraphWeightedDirected
 
@@ -83,6 +85,19 @@ protected:
         s.close();
     }
 
+    // lecture multi-thread depuis un fichier. Produit le meme graphe que
+    // ReadFromFile. Utilise addEdge(...) a definir par les classe fille, une
+    // fois toutes les lignes analysees.
+    void ReadFromFileParallel(const std::string& filename, unsigned nbThreads) {
+        typename GraphTextParser<WeightType>::Data data =
+                GraphTextParser<WeightType>::Parse(filename, nbThreads);
+
+        edgeAdjacencyLists.resize(data.V);
+
+        for (const auto& e : data.edges)
+            addEdge(e.v, e.w, e.weight);
+    }
+
     // lecture depuis un stream. Utilise addEdge(...)
     // a definir par les classe fille
     void ReadFromStream(std::istream& s) {
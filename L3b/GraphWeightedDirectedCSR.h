@@ -0,0 +1,78 @@
+/*
+ * File:   GraphWeightedDirectedCSR.h
+ * Author: Berney Alec, Forestier Quentin, Herzig Melvyn
+ *
+ * Created on 17. octobre 2026
+ */
+
+#ifndef ASD2_GraphWeightedDirectedCSR_h
+#define ASD2_GraphWeightedDirectedCSR_h
+
+#include "GraphWeightedCSRCommon.h"
+#include "GraphWeightedDirected.h"
+
+// Classe definissant un graphe pondere oriente immuable au format CSR.
+// Elle offre la meme interface de parcours que GraphWeightedDirected et peut
+// donc etre passee telle quelle aux algorithmes de ShortestPath.
+
+template<typename T> // Type du poids, par exemple int ou double
+class GraphWeightedDirectedCSR : public GraphWeightedCSRCommon<EdgeWeightedDirected<T>> {
+// defini la class mere comme BASE.
+   typedef GraphWeightedCSRCommon<EdgeWeightedDirected<T>> BASE;
+
+public:
+   // Type des arcs
+   typedef typename BASE::Edge Edge;
+
+   // Type de donnée pour les poids
+   typedef typename BASE::WeightType WeightType;
+
+   // Constructeur a partir d'un graphe a listes d'adjacence.
+   explicit GraphWeightedDirectedCSR(const GraphWeightedDirected<T>& g) {
+      this->build(g, [] (int, const Edge& e) { return e.To(); });
+   }
+
+   // Constructeur a partir d'un fichier binaire ecrit par Save. Le fichier
+   // est projete en memoire puis relu une fois pour etre verifie: l'arc
+   // range chez v doit partir de v et arriver a son target.
+   explicit GraphWeightedDirectedCSR(const std::string& binaryFilename) {
+      this->map(binaryFilename, true, [] (int v, const Edge& e, int w) {
+         return e.From() == v && e.To() == w;
+      });
+   }
+
+   // Ecrit le graphe au format binaire
+   void Save(const std::string& binaryFilename) const {
+      this->save(binaryFilename, true);
+   }
+
+   // Lit un fichier texte "V E" puis "v w weight" avec nbThreads threads
+   // (0 pour utiliser tous les coeurs), sans passer par GraphWeightedDirected.
+   static GraphWeightedDirectedCSR FromText(const std::string& textFilename, unsigned nbThreads = 0) {
+      typename GraphTextParser<T>::Data data = GraphTextParser<T>::Parse(textFilename, nbThreads);
+      GraphWeightedDirectedCSR g;
+      g.buildFromEntries(data.V, data.edges, true);
+      return g;
+   }
+
+   // Convertit un fichier texte "V E" puis "v w weight" en fichier binaire
+   static void ConvertFromText(const std::string& textFilename, const std::string& binaryFilename) {
+      FromText(textFilename).Save(binaryFilename);
+   }
+
+private:
+   GraphWeightedDirectedCSR() {}
+
+public:
+
+   // Parcours de tous les arcs du graphe.
+   // la fonction f doit prendre un seul argument de type
+   // GraphWeightedDirectedCSR::Edge
+   template<typename Func>
+   void forEachEdge(Func f) const {
+      for (int i = 0; i < this->offsets[this->V()]; ++i)
+         f(this->edges[i]);
+   }
+};
+
+#endif
@@ -0,0 +1,229 @@
+/*
+ * File:   IndexMinPQ.h
+ * Author: Berney Alec, Forestier Quentin, Herzig Melvyn
+ *
+ * Created on 17. octobre 2026
+ */
+
+#ifndef ASD2_IndexMinPQ_h
+#define ASD2_IndexMinPQ_h
+
+#include <algorithm>
+#include <vector>
+#include <set>
+#include <utility>
+
+// Files de priorité indexées par des sommets 0..N-1, utilisables comme
+// politique de file par DijkstraSP. Toutes deux offrent la même interface:
+//   empty(), contains(v), minVertex(), push(v, key), decreaseKey(v, key)
+//   et popMin().
+
+/**
+ * @brief Tas d-aire indexé avec une vraie opération decreaseKey.
+ * @tparam Key Type des priorités, doit être comparable avec operator<.
+ * @tparam D Arité du tas. Un tas 4-aire est plus plat qu'un tas binaire
+ *         et fait moins de défauts de cache lors des descentes.
+ * @details pos[v] donne la position de v dans heap, ou -1 si v n'est pas
+ *          dans la file. Aucune allocation n'est faite après la construction.
+ */
+template<typename Key, int D = 4>
+class IndexMinPQ
+{
+   static_assert(D >= 2, "IndexMinPQ : l'arite doit valoir au moins 2");
+
+   // Sommets, ordonnés en tas selon keys.
+   std::vector<int> heap;
+
+   // Position de chaque sommet dans heap, -1 si absent.
+   std::vector<int> pos;
+
+   // Priorité de chaque sommet présent dans la file.
+   std::vector<Key> keys;
+
+   void place (int i, int v)
+   {
+      heap[i] = v;
+      pos[v] = i;
+   }
+
+   void siftUp (int i)
+   {
+      int v = heap[i];
+      while (i > 0)
+      {
+         int parent = (i - 1) / D;
+         if (!(keys[v] < keys[heap[parent]])) break;
+         place(i, heap[parent]);
+         i = parent;
+      }
+      place(i, v);
+   }
+
+   void siftDown (int i)
+   {
+      int v = heap[i];
+      int n = int(heap.size());
+      while (true)
+      {
+         int first = i * D + 1;
+         if (first >= n) break;
+
+         int last = std::min(first + D, n);
+         int best = first;
+         for (int c = first + 1; c < last; ++c)
+         {
+            if (keys[heap[c]] < keys[heap[best]]) best = c;
+         }
+
+         if (!(keys[heap[best]] < keys[v])) break;
+         place(i, heap[best]);
+         i = best;
+      }
+      place(i, v);
+   }
+
+public:
+
+   /**
+    * @brief Construit une file vide pouvant contenir les sommets 0..N-1.
+    * @param N Nombre de sommets.
+    */
+   explicit IndexMinPQ (int N) : pos(N, -1), keys(N)
+   {
+      heap.reserve(N);
+   }
+
+   bool empty () const
+   {
+      return heap.empty();
+   }
+
+   // Vide la file, en temps proportionnel au nombre de sommets présents
+   void clear ()
+   {
+      for (int v : heap) pos[v] = -1;
+      heap.clear();
+   }
+
+   bool contains (int v) const
+   {
+      return pos[v] != -1;
+   }
+
+   // Renvoie le sommet de plus petite priorité, sans le retirer
+   int minVertex () const
+   {
+      return heap.front();
+   }
+
+   /**
+    * @brief Ajoute le sommet v avec la priorité key.
+    * @details v ne doit pas déjà être dans la file.
+    */
+   void push (int v, Key key)
+   {
+      keys[v] = key;
+      heap.push_back(v);
+      siftUp(int(heap.size()) - 1);
+   }
+
+   /**
+    * @brief Diminue la priorité du sommet v à key.
+    * @details v doit être dans la file et key ne doit pas être plus grand que sa
+    *          priorité actuelle.
+    */
+   void decreaseKey (int v, Key key)
+   {
+      keys[v] = key;
+      siftUp(pos[v]);
+   }
+
+   /**
+    * @brief Retire le sommet de plus petite priorité.
+    * @return Numéro du sommet retiré.
+    */
+   int popMin ()
+   {
+      int v = heap.front();
+      pos[v] = -1;
+
+      int last = heap.back();
+      heap.pop_back();
+      if (!heap.empty())
+      {
+         heap.front() = last;
+         siftDown(0);
+      }
+      return v;
+   }
+};
+
+/**
+ * @brief File de priorité indexée mise en oeuvre avec std::set.
+ * @tparam Key Type des priorités, doit être comparable avec operator<.
+ * @details Correspond à l'ancienne file de DijkstraSP. decreaseKey se fait en
+ *          deux opérations (erase puis insert), chacune allouant ou libérant
+ *          un noeud.
+ */
+template<typename Key>
+class SetMinPQ
+{
+   typedef std::pair<Key, int> KeyVertex;
+
+   std::set<KeyVertex> PQ;
+
+   // Priorité de chaque sommet présent dans la file.
+   std::vector<Key> keys;
+
+   std::vector<bool> inQueue;
+
+public:
+
+   explicit SetMinPQ (int N) : keys(N), inQueue(N, false)
+   {}
+
+   bool empty () const
+   {
+      return PQ.empty();
+   }
+
+   void clear ()
+   {
+      for (const KeyVertex &kv : PQ) inQueue[kv.second] = false;
+      PQ.clear();
+   }
+
+   bool contains (int v) const
+   {
+      return inQueue[v];
+   }
+
+   void push (int v, Key key)
+   {
+      keys[v] = key;
+      inQueue[v] = true;
+      PQ.insert(std::make_pair(key, v));
+   }
+
+   void decreaseKey (int v, Key key)
+   {
+      PQ.erase(std::make_pair(keys[v], v));
+      keys[v] = key;
+      PQ.insert(std::make_pair(key, v));
+   }
+
+   int minVertex () const
+   {
+      return PQ.begin()->second;
+   }
+
+   int popMin ()
+   {
+      int v = PQ.begin()->second;
+      PQ.erase(PQ.begin());
+      inQueue[v] = false;
+      return v;
+   }
+};
+
+#endif
@@ -0,0 +1,317 @@
+/*
+ * File:   Landmarks.h
+ * Author: Berney Alec, Forestier Quentin, Herzig Melvyn
+ *
+ * Created on 17. octobre 2026
+ */
+
+#ifndef ASD2_Landmarks_h
+#define ASD2_Landmarks_h
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "EdgeWeightedDirected.h"
+#include "ShortestPath.h"
+
+//  Prétraitement ALT (A*, Landmarks, inégalité Triangulaire) pour guider
+//  AStarSP sur un graphe sans géométrie.
+//
+//  Pour chaque repère L, on stocke d(L, v) et d(v, L) pour tout sommet v.
+//  L'inégalité triangulaire donne alors deux minorants de d(v, t):
+//     d(v, L) - d(t, L)   et   d(L, t) - d(L, v)
+//  et le plus grand d'entre eux, sur tous les repères, est un minorant
+//  cohérent.
+//
+//  Les distances sont stockées en float arrondis vers le bas, soit
+//  2 * V * k * 4 octets pour k repères. À la lecture, la valeur soustraite est
+//  majorée de son erreur d'arrondi pour que le minorant reste valide.
+//
+//  Format du fichier écrit par Save, en ordre d'octets natif:
+//    - LandmarksHeader
+//    - landmarks : k int32
+//    - from      : V * k float, d(landmarks[i], v) à l'indice v * k + i
+//    - to        : V * k float, d(v, landmarks[i]) à l'indice v * k + i
+//  L'empreinte du graphe est vérifiée à la lecture: un fichier calculé sur
+//  une autre version du graphe est refusé.
+
+// En-tête des fichiers de repères.
+struct LandmarksHeader {
+   char     magic[8];      // "ASD2ALT" suivi d'un octet nul
+   uint32_t version;       // LANDMARKS_VERSION
+   uint32_t nbLandmarks;   // k
+   int64_t  V;             // nombre de sommets
+   uint64_t fingerprint;   // empreinte des arcs du graphe
+};
+
+static const char LANDMARKS_MAGIC[8] = "ASD2ALT";
+static const uint32_t LANDMARKS_VERSION = 1;
+
+template<typename GraphType> // Type du graphe pondere oriente, a poids positifs
+class Landmarks {
+public:
+   typedef double Weight;
+   typedef EdgeWeightedDirected<Weight> Edge;
+
+private:
+   // Graphe inverse de g, au format CSR, pour les distances jusqu'aux repères
+   class Reverse {
+   public:
+      typedef EdgeWeightedDirected<Weight> Edge;
+
+   private:
+      std::vector<int> offsets;
+      std::vector<Edge> edges;
+
+   public:
+      explicit Reverse(const GraphType& g) : offsets(g.V() + 1, 0) {
+         g.forEachEdge([&](const typename GraphType::Edge& e) { ++offsets[e.To() + 1]; });
+         for (int v = 0; v < g.V(); ++v)
+            offsets[v + 1] += offsets[v];
+
+         edges.resize(offsets[g.V()]);
+         std::vector<int> next(offsets.begin(), offsets.end() - 1);
+         g.forEachEdge([&](const typename GraphType::Edge& e) {
+            edges[next[e.To()]++] = Edge(e.To(), e.From(), e.Weight());
+         });
+      }
+
+      int V() const {
+         return int(offsets.size()) - 1;
+      }
+
+      template<typename Func>
+      void forEachVertex(Func f) const {
+         for (int v = 0; v < V(); ++v)
+            f(v);
+      }
+
+      template<typename Func>
+      void forEachAdjacentEdge(int v, Func f) const {
+         for (int i = offsets[v]; i < offsets[v + 1]; ++i)
+            f(edges[i]);
+      }
+   };
+
+   int nbVertices;
+   std::vector<int> landmarks;
+   std::vector<float> from;
+   std::vector<float> to;
+   uint64_t fingerprint;
+
+   // Empreinte FNV-1a de V et des arcs de g, dans l'ordre de forEachEdge
+   static uint64_t fingerprintOf(const GraphType& g) {
+      uint64_t hash = 14695981039346656037ULL;
+      auto mix = [&hash](const void* data, size_t size) {
+         const unsigned char* bytes = static_cast<const unsigned char*>(data);
+         for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+         }
+      };
+
+      int V = g.V();
+      mix(&V, sizeof(V));
+      g.forEachEdge([&](const typename GraphType::Edge& e) {
+         int v = e.From(), w = e.To();
+         Weight weight = e.Weight();
+         mix(&v, sizeof(v));
+         mix(&w, sizeof(w));
+         mix(&weight, sizeof(weight));
+      });
+      return hash;
+   }
+
+   // Arrondi de d vers le bas en float, l'infini représentant les sommets inaccessibles
+   static float roundDown(Weight d) {
+      if (d == std::numeric_limits<Weight>::max())
+         return std::numeric_limits<float>::infinity();
+      float f = float(d);
+      if (Weight(f) > d)
+         f = std::nextafter(f, -std::numeric_limits<float>::infinity());
+      return f;
+   }
+
+   // Minorant a - b d'une différence de distances. b est majoré de son erreur
+   // d'arrondi (au plus 2^-23 en relatif). Si b est infini, il n'apprend rien;
+   // si seul a l'est, la destination est inaccessible.
+   static Weight difference(float a, float b) {
+      static const Weight ROUND_UP = 1 + 1.0 / (1 << 22);
+      if (b == std::numeric_limits<float>::infinity()) return 0;
+      if (a == std::numeric_limits<float>::infinity()) return std::numeric_limits<Weight>::max();
+      return Weight(a) - Weight(b) * ROUND_UP;
+   }
+
+public:
+
+   /**
+    * @brief Choisit k repères dans g et calcule leurs tables de distances.
+    * @param g Graphe à traîter, qui doit aussi définir forEachEdge(Func).
+    * @param k Nombre de repères souhaité.
+    * @details Choix du plus éloigné: chaque repère est le sommet dont la plus
+    *          petite distance (dans un sens ou dans l'autre) aux repères déjà
+    *          choisis, et au sommet 0 pour le premier, est la plus grande. Les
+    *          sommets inaccessibles sont donc pris en premier. Moins de k
+    *          repères sont choisis si tous les sommets sont déjà à distance
+    *          nulle d'un repère, mais toujours au moins un si g a un sommet.
+    * @throws std::runtime_error si k < 1.
+    */
+   Landmarks(const GraphType& g, int k)
+           : nbVertices(g.V()), fingerprint(fingerprintOf(g)) {
+      if (k < 1)
+         throw std::runtime_error("Landmarks : il faut au moins un repere");
+      if (nbVertices == 0) return;
+
+      Reverse reverse(g);
+
+      std::vector<Weight> closest(nbVertices);
+      DijkstraSP<GraphType> start(g, 0);
+      for (int v = 0; v < nbVertices; ++v)
+         closest[v] = start.distanceToVertex(v);
+
+      std::vector<std::vector<float>> fromL, toL;
+      for (int i = 0; i < k; ++i) {
+         int L = int(std::max_element(closest.begin(), closest.end()) - closest.begin());
+         if (closest[L] == 0 && i > 0) break;
+
+         DijkstraSP<GraphType> forward(g, L);
+         DijkstraSP<Reverse> backward(reverse, L);
+
+         landmarks.push_back(L);
+         fromL.emplace_back(nbVertices);
+         toL.emplace_back(nbVertices);
+         for (int v = 0; v < nbVertices; ++v) {
+            Weight dFrom = forward.distanceToVertex(v), dTo = backward.distanceToVertex(v);
+            fromL.back()[v] = roundDown(dFrom);
+            toL.back()[v] = roundDown(dTo);
+            closest[v] = std::min(closest[v], std::min(dFrom, dTo));
+         }
+      }
+
+      // Passage à la disposition v * k + i, les k valeurs d'un sommet étant
+      // lues ensemble par lowerBound
+      size_t nb = landmarks.size();
+      from.resize(nbVertices * nb);
+      to.resize(nbVertices * nb);
+      for (size_t i = 0; i < nb; ++i)
+         for (int v = 0; v < nbVertices; ++v) {
+            from[v * nb + i] = fromL[i][v];
+            to[v * nb + i] = toL[i][v];
+         }
+   }
+
+   /**
+    * @brief Lit les repères de g dans un fichier écrit par Save.
+    * @param g Graphe sur lequel les repères ont été calculés.
+    * @param filename Nom du fichier.
+    * @throws std::runtime_error si le fichier est absent, tronqué, d'une autre
+    *         version, calculé sur un autre graphe, ou si son nombre de
+    *         repères, sa taille ou ses repères sont invalides.
+    * @details La taille du fichier est comparée à celle annoncée par
+    *          l'en-tête avant toute allocation.
+    */
+   Landmarks(const GraphType& g, const std::string& filename)
+           : nbVertices(g.V()), fingerprint(fingerprintOf(g)) {
+      std::ifstream s(filename, std::ios::binary);
+      if (!s)
+         throw std::runtime_error("Landmarks : impossible de lire " + filename);
+
+      LandmarksHeader h;
+      if (!s.read(reinterpret_cast<char*>(&h), sizeof(h)))
+         throw std::runtime_error("Landmarks : fichier trop court " + filename);
+      if (std::memcmp(h.magic, LANDMARKS_MAGIC, sizeof(LANDMARKS_MAGIC)) != 0)
+         throw std::runtime_error("Landmarks : format inconnu " + filename);
+      if (h.version != LANDMARKS_VERSION)
+         throw std::runtime_error("Landmarks : version non supportee " + filename);
+      if (h.V != nbVertices || h.fingerprint != fingerprint)
+         throw std::runtime_error("Landmarks : fichier calcule sur un autre graphe " + filename);
+
+      // Au moins un repère dès que le graphe a un sommet, au plus V
+      if (h.nbLandmarks > uint32_t(nbVertices) || (h.nbLandmarks == 0 && nbVertices > 0))
+         throw std::runtime_error("Landmarks : nombre de reperes invalide " + filename);
+
+      // Chaque repère occupe un int32 et 2 * V float, le reste du fichier
+      // doit en contenir exactement nbLandmarks
+      s.seekg(0, std::ios::end);
+      uint64_t payload = uint64_t(s.tellg()) - sizeof(h);
+      uint64_t perLandmark = sizeof(int) + 2 * uint64_t(nbVertices) * sizeof(float);
+      if (payload / perLandmark != h.nbLandmarks || payload % perLandmark != 0)
+         throw std::runtime_error("Landmarks : taille de fichier invalide " + filename);
+      s.seekg(sizeof(h));
+
+      landmarks.resize(h.nbLandmarks);
+      from.resize(size_t(nbVertices) * h.nbLandmarks);
+      to.resize(from.size());
+      s.read(reinterpret_cast<char*>(landmarks.data()), landmarks.size() * sizeof(int));
+      s.read(reinterpret_cast<char*>(from.data()), from.size() * sizeof(float));
+      s.read(reinterpret_cast<char*>(to.data()), to.size() * sizeof(float));
+      if (!s)
+         throw std::runtime_error("Landmarks : fichier tronque " + filename);
+
+      for (int L : landmarks)
+         if (L < 0 || L >= nbVertices)
+            throw std::runtime_error("Landmarks : repere invalide " + filename);
+   }
+
+   /**
+    * @brief Ecrit les repères et leurs tables dans un fichier binaire.
+    * @param filename Nom du fichier à écrire.
+    */
+   void Save(const std::string& filename) const {
+      std::ofstream s(filename, std::ios::binary);
+      if (!s)
+         throw std::runtime_error("Landmarks : impossible d'ecrire " + filename);
+
+      LandmarksHeader h;
+      std::memset(&h, 0, sizeof(h));
+      std::memcpy(h.magic, LANDMARKS_MAGIC, sizeof(LANDMARKS_MAGIC));
+      h.version     = LANDMARKS_VERSION;
+      h.nbLandmarks = uint32_t(landmarks.size());
+      h.V           = nbVertices;
+      h.fingerprint = fingerprint;
+
+      s.write(reinterpret_cast<const char*>(&h), sizeof(h));
+      s.write(reinterpret_cast<const char*>(landmarks.data()), landmarks.size() * sizeof(int));
+      s.write(reinterpret_cast<const char*>(from.data()), from.size() * sizeof(float));
+      s.write(reinterpret_cast<const char*>(to.data()), to.size() * sizeof(float));
+
+      if (!s)
+         throw std::runtime_error("Landmarks : erreur d'ecriture " + filename);
+   }
+
+   // Renvoie les repères choisis
+   const std::vector<int>& Vertices() const {
+      return landmarks;
+   }
+
+   /**
+    * @brief Renvoie un minorant de la distance de v à t.
+    * @details numeric_limits<double>::max() si t est certainement inaccessible
+    *          depuis v.
+    */
+   Weight lowerBound(int v, int t) const {
+      size_t nb = landmarks.size();
+      const float* fromV = from.data() + v * nb;
+      const float* fromT = from.data() + t * nb;
+      const float* toV = to.data() + v * nb;
+      const float* toT = to.data() + t * nb;
+
+      Weight best = 0;
+      for (size_t i = 0; i < nb; ++i)
+         best = std::max(best, std::max(difference(toV[i], toT[i]), difference(fromT[i], fromV[i])));
+      return best;
+   }
+
+   // Permet de passer les repères tels quels à AStarSP
+   Weight operator()(int v, int t) const {
+      return lowerBound(v, t);
+   }
+};
+
+#endif
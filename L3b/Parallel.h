@@ -0,0 +1,92 @@
+/*
+ * File:   Parallel.h
+ * Author: Berney Alec, Forestier Quentin, Herzig Melvyn
+ *
+ * Created on 17. octobre 2026
+ */
+
+#ifndef ASD2_Parallel_h
+#define ASD2_Parallel_h
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Renvoie le nombre de threads à utiliser.
+ * @param nbThreads Nombre demandé, 0 pour laisser choisir la machine.
+ * @return nbThreads s'il est non nul, sinon le nombre de coeurs (au moins 1).
+ */
+inline unsigned threadCount (unsigned nbThreads = 0)
+{
+   if (nbThreads != 0) return nbThreads;
+   return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Découpe [0, n) en nbThreads tranches contiguës et applique f à chacune
+ *        dans son propre thread.
+ * @param nbThreads Nombre de tranches (et de threads).
+ * @param n Taille de l'intervalle à découper.
+ * @param f Fonction (unsigned t, int begin, int end) appelée pour la tranche t.
+ * @details La tranche 0 est traitée par le thread appelant. Lorsque
+ *          nbThreads vaut 1, aucun thread n'est créé.
+ */
+template<typename Func>
+void parallelFor (unsigned nbThreads, int n, Func f)
+{
+   std::vector<std::thread> workers;
+   workers.reserve(nbThreads - 1);
+
+   for (unsigned t = 1; t < nbThreads; ++t)
+   {
+      int begin = int((long long) n * t / nbThreads);
+      int end   = int((long long) n * (t + 1) / nbThreads);
+      workers.emplace_back([=, &f] { f(t, begin, end); });
+   }
+
+   f(0u, 0, int((long long) n / nbThreads));
+
+   for (std::thread& w : workers)
+      w.join();
+}
+
+/**
+ * @brief Barrière de synchronisation réutilisable entre nbThreads threads.
+ * @details wait() bloque jusqu'à ce que les nbThreads threads l'aient appelé,
+ *          puis les libère tous. La barrière est aussitôt prête pour le tour
+ *          suivant. Tout ce qu'un thread a écrit avant wait() est visible des
+ *          autres après.
+ */
+class Barrier
+{
+   std::mutex mutex;
+   std::condition_variable released;
+   const unsigned nbThreads;
+   unsigned nbWaiting;
+   unsigned long generation;
+
+public:
+   explicit Barrier (unsigned nbThreads) : nbThreads(nbThreads), nbWaiting(0), generation(0)
+   {}
+
+   void wait ()
+   {
+      std::unique_lock<std::mutex> lock(mutex);
+      unsigned long current = generation;
+      if (++nbWaiting == nbThreads)
+      {
+         nbWaiting = 0;
+         ++generation;
+         released.notify_all();
+      }
+      else
+      {
+         released.wait(lock, [&] { return generation != current; });
+      }
+   }
+};
+
+#endif
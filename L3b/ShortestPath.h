@@ -10,11 +10,14 @@
 #define ASD2_ShortestPath_h
 
 #include <algorithm>
+#include <limits>
 #include <queue>
 #include <vector>
 #include <set>
 #include <functional>
 #include "EdgeWeightedDirected.h"
+#include "IndexMinPQ.h"
+#include "Parallel.h"
 
 // Classe parente de toutes les classes de plus court chemin.
 // Defini les membres edgeTo et distanceTo commun à toutes ces
@@ -70,21 +73,23 @@ private:
     typedef typename BASE::Edge Edge;
     typedef typename BASE::Weight Weight;
 
-    // Relachement de l'arc e
-    void relax(const Edge& e) {
+    // Relachement de l'arc e. Renvoie vrai si distanceTo a diminue.
+    bool relax(const Edge& e) {
         int v = e.From(), w = e.To();
         Weight distThruE = this->distanceTo[v] + e.Weight();
 
         if (this->distanceTo[w] > distThruE) {
             this->distanceTo[w] = distThruE;
             this->edgeTo[w] = e;
+            return true;
         }
+        return false;
     }
 
 public:
 
     // Constructeur a partir du graphe g et du sommet v a la source
-    // des plus courts chemins
+    // des plus courts chemins. S'arrete des qu'une passe ne relache aucun arc.
     BellmanFordSP(const GraphType& g, int v) {
 
         this->edgeTo.resize(g.V());
@@ -93,10 +98,13 @@ public:
         this->edgeTo[v] = Edge(v, v, 0);
         this->distanceTo[v] = 0;
 
-        for (int i = 0; i < g.V() - 1; ++i)
-            g.forEachEdge([this](const Edge& e) {
-                this->relax(e);
+        bool changed = true;
+        for (int i = 0; i < g.V() - 1 && changed; ++i) {
+            changed = false;
+            g.forEachEdge([this, &changed](const Edge& e) {
+                if (this->relax(e)) changed = true;
             });
+        }
     }
 };
 
@@ -106,66 +114,39 @@ public:
  *         forEachVertex(Func) et forEachAdjacentEdge(int, Func), ainsi que le type
  *         GraphType::Edge. Ce dernier doit se comporter comme EdgeWeightedDirected,
  *         c-a-dire definir From(), To et Weight.
+ * @tparam PriorityQueue File de priorité indexée des sommets à traîter, voir
+ *         IndexMinPQ.h. Par défaut un tas 4-aire avec decreaseKey.
  */
-template<typename GraphType>
+template<typename GraphType, typename PriorityQueue = IndexMinPQ<double>>
 class DijkstraSP : public ShortestPath<GraphType> {
 public:
 
     typedef ShortestPath<GraphType> BASE;
     typedef typename BASE::Edge Edge;
     typedef typename BASE::Weight Weight;
-    typedef std::pair<Weight, int> WeightVertex;
 
 private:
 
     /**
-     * @brief Priority Queue des paires <Poids, sommet> à traîter.
+     * @brief Priority Queue des sommets atteints mais pas encore traîtés.
      */
-    std::set<WeightVertex> PQ;
-
-    /**
-     * @brief Retire la paire <poids, sommet> ou poids est le plus petit de PQ.
-     * @return WeightVertex contenant le plus petit poids de PQ.
-     */
-    WeightVertex extract_min()
-    {
-       WeightVertex e = *PQ.begin();
-       PQ.erase(PQ.begin());
-       return e;
-    }
-
-    /**
-     * @brief Retire la paire <oldWeight, v> et la remplace par <newWeight, v> dans PQ.
-     * @param oldWeight Ancien poids de v.
-     * @param newWeight Nouveau poids de v.
-     * @param v Sommet v.
-     */
-    void decrease_priority(Weight oldWeight, Weight newWeight, int v)
-    {
-       PQ.erase(std::make_pair(oldWeight, v));
-       PQ.insert(std::make_pair(newWeight, v));
-    };
-
-    /**
-     * @brief Ajoute la paire WeightVertex (w, i) à la pq.
-     * @param i Numéro du sommet.
-     * @param w Poids jusqu'au sommet.
-     */
-    void add_with_priority(int i, Weight w)
-    {
-       PQ.insert(std::make_pair(w, i));
-    }
+    PriorityQueue PQ;
 
     /**
      * @brief Relâche l'arc e.
      * @param e Arc à relâcher.
+     * @details Un sommet n'entre dans PQ que lorsqu'il est atteint pour la
+     *          première fois.
      */
     void relax(const Edge& e) {
        int v = e.From(), w = e.To();
        Weight distThruE = this->distanceTo[v] + e.Weight();
 
        if (this->distanceTo[w] > distThruE) {
-          decrease_priority(this->distanceTo[w], distThruE, w);
+          if (PQ.contains(w))
+             PQ.decreaseKey(w, distThruE);
+          else
+             PQ.push(w, distThruE);
           this->distanceTo[w] = distThruE;
           this->edgeTo[w] = e;
        }
@@ -178,7 +159,7 @@ public:
      * @param g Graphe à traîter.
      * @param v Sommet de départ.
      */
-    DijkstraSP(const GraphType& g, int v) {
+    DijkstraSP(const GraphType& g, int v) : PQ(g.V()) {
 
        //Initialisation
        this->edgeTo.resize(g.V());
@@ -187,22 +168,319 @@ public:
        this->edgeTo[v] = Edge(v, v, 0);
        this->distanceTo[v] = 0;
 
-       g.forEachVertex([&](int i)
-       {
-         add_with_priority(i, this->distanceTo[i]);
-       });
+       PQ.push(v, 0);
 
-       //Traitement de chaque plus petite paire WeightVertex restante dans PQ.
+       //Traitement de chaque sommet atteint, par distance croissante.
        while(!PQ.empty())
        {
-          WeightVertex ew = extract_min();
+          int u = PQ.popMin();
 
-          g.forEachAdjacentEdge(ew.second, [&](const Edge& e){
+          g.forEachAdjacentEdge(u, [&](const Edge& e){
              relax(e);
           });
        }
     }
 };
 
+/**
+ * @brief Plus court chemin d'un sommet source à un sommet destination par
+ *        l'algorithme A*.
+ * @tparam GraphType Type du graphe pondéré orienté à traiter, à poids positifs.
+ *         Doit définir V() et forEachAdjacentEdge(int, Func).
+ * @details C'est l'algorithme de Dijkstra où la clé d'un sommet v est sa
+ *          distance depuis la source augmentée d'un minorant h(v, t) de sa
+ *          distance jusqu'à la destination t. Le calcul s'arrête dès que la
+ *          destination est retirée de la file.
+ *
+ *          Le minorant doit être cohérent, c-a-d h(u, t) <= poids(u->w) +
+ *          h(w, t) pour tout arc u->w (voir Landmarks). Un minorant nul
+ *          redonne Dijkstra.
+ */
+template<typename GraphType>
+class AStarSP {
+public:
+
+    typedef double Weight;
+    typedef EdgeWeightedDirected<Weight> Edge;
+    typedef std::vector<Edge> Edges;
+
+private:
+
+    int source, target;
+    std::vector<Weight> distTo;
+    Edges edgeTo;
+
+    // Nombre de sommets retirés de la file
+    int nbSettled;
+
+public:
+
+    /**
+     * @brief Calcule le plus court chemin de s à t dans g.
+     * @param g Graphe à traîter.
+     * @param s Sommet source.
+     * @param t Sommet destination.
+     * @param h Fonction (int v, int t) renvoyant un minorant de la distance de
+     *          v à t. Elle n'est pas copiée et doit survivre au constructeur.
+     */
+    template<typename Heuristic>
+    AStarSP(const GraphType& g, int s, int t, const Heuristic& h)
+            : source(s), target(t), distTo(g.V(), std::numeric_limits<Weight>::max()), edgeTo(g.V()), nbSettled(0) {
+       IndexMinPQ<Weight> PQ(g.V());
+
+       distTo[s] = 0;
+       PQ.push(s, h(s, t));
+
+       while(!PQ.empty())
+       {
+          int u = PQ.popMin();
+          ++nbSettled;
+          if (u == t) break;
+
+          g.forEachAdjacentEdge(u, [&](const Edge& e){
+             int w = e.To();
+             Weight d = distTo[u] + e.Weight();
+             if (d < distTo[w]) {
+                // Un sommet déjà traité n'est remis dans la file que si le
+                // minorant n'est pas tout à fait cohérent (arrondis).
+                distTo[w] = d;
+                edgeTo[w] = e;
+                if (PQ.contains(w))
+                   PQ.decreaseKey(w, d + h(w, t));
+                else
+                   PQ.push(w, d + h(w, t));
+             }
+          });
+       }
+    }
+
+    // Indique si la destination est accessible depuis la source
+    bool hasPath() const {
+       return distTo[target] != std::numeric_limits<Weight>::max();
+    }
+
+    // Renvoie la longueur du plus court chemin, ou numeric_limits<double>::max()
+    // si la destination est inaccessible
+    Weight distance() const {
+       return distTo[target];
+    }
+
+    // Renvoie le nombre de sommets traîtés par la recherche
+    int nbExplored() const {
+       return nbSettled;
+    }
+
+    // Renvoie la liste ordonnée des arcs du plus court chemin de la source
+    // à la destination, vide si elle est inaccessible
+    Edges Path() const {
+       Edges result;
+       Path(result);
+       return result;
+    }
+
+    // Remplace le contenu de result par les arcs du plus court chemin, ce
+    // qui évite une allocation si result a déjà servi
+    void Path(Edges& result) const {
+       result.clear();
+       if (!hasPath()) return;
+
+       for (int v = target; v != source; v = edgeTo[v].From())
+          result.push_back(edgeTo[v]);
+       std::reverse(result.begin(), result.end());
+    }
+};
+
+/**
+ * @brief Plus courts chemins par delta-stepping parallèle (Meyer et Sanders).
+ * @tparam GraphType Doit se comporter comme un GraphWeightedDirected et définir V()
+ *         et forEachAdjacentEdge(int, Func), ainsi que le type GraphType::Edge.
+ *         Les poids doivent être positifs ou nuls.
+ * @details Les sommets atteints sont rangés dans des seaux de largeur delta
+ *          selon leur distance. Les seaux sont traités dans l'ordre: les arcs
+ *          légers (poids <= delta) des sommets du seau courant sont relâchés
+ *          jusqu'à ce qu'il soit vide, puis les arcs lourds des sommets qui en
+ *          sont sortis, une seule fois.
+ *
+ *          Chaque thread possède une tranche contiguë de sommets: lui seul
+ *          écrit leurs distanceTo, edgeTo et seaux. Un relâchement vers le
+ *          sommet d'un autre thread est déposé dans un tampon de requêtes propre
+ *          à la paire (émetteur, propriétaire), que le propriétaire applique
+ *          après une barrière. Aucune opération atomique n'est donc nécessaire.
+ */
+template<typename GraphType>
+class DeltaSteppingSP : public ShortestPath<GraphType> {
+public:
+
+    typedef ShortestPath<GraphType> BASE;
+    typedef typename BASE::Edge Edge;
+    typedef typename BASE::Weight Weight;
+
+private:
+
+    // Demande de relâchement: distance proposée pour e.To() par l'arc e
+    struct Request {
+       Edge e;
+       Weight distance;
+    };
+
+    Weight delta;
+
+    /**
+     * @brief Choisit delta: poids maximal divisé par le degré moyen, mais au
+     *        moins le plus petit poids non nul, et 1 si tous les poids sont nuls.
+     * @details Avec des poids aléatoires, c'est l'ordre de grandeur qui équilibre
+     *          le nombre de seaux et le travail refait dans chaque seau.
+     */
+    static Weight autoDelta(const GraphType& g) {
+       Weight maxWeight = 0, minWeight = std::numeric_limits<Weight>::max();
+       long long nbEdges = 0;
+       for (int v = 0; v < g.V(); ++v) {
+          g.forEachAdjacentEdge(v, [&](const Edge& e) {
+             maxWeight = std::max(maxWeight, e.Weight());
+             if (e.Weight() > 0) minWeight = std::min(minWeight, e.Weight());
+             ++nbEdges;
+          });
+       }
+       if (maxWeight <= 0) return 1;
+
+       double averageDegree = std::max(1.0, double(nbEdges) / std::max(1, g.V()));
+       return std::max(minWeight, maxWeight / averageDegree);
+    }
+
+public:
+
+    /**
+     * @brief Calcule les plus courts chemins depuis v.
+     * @param g Graphe à traîter, poids positifs ou nuls.
+     * @param v Sommet de départ.
+     * @param nbThreads Nombre de threads, 0 pour utiliser tous les coeurs.
+     * @param delta Largeur des seaux, 0 pour la choisir automatiquement.
+     */
+    DeltaSteppingSP(const GraphType& g, int v, unsigned nbThreads = 0, Weight delta = 0)
+            : delta(delta > 0 ? delta : autoDelta(g)) {
+
+       const int V = g.V();
+       const unsigned T = std::max(1u, std::min(threadCount(nbThreads), unsigned(V)));
+       const int chunk = (V + int(T) - 1) / int(T);
+
+       this->edgeTo.resize(V);
+       this->distanceTo.assign(V, std::numeric_limits<Weight>::max());
+
+       // Poids maximal, pour borner le nombre de seaux vivants
+       Weight maxWeight = 0;
+       for (int u = 0; u < V; ++u)
+          g.forEachAdjacentEdge(u, [&](const Edge& e) { maxWeight = std::max(maxWeight, e.Weight()); });
+
+       // Seaux circulaires: toutes les distances en attente sont dans
+       // [courant * delta, courant * delta + maxWeight + delta)
+       const long long nbBuckets = (long long)(maxWeight / this->delta) + 2;
+
+       auto bucketOf = [&](Weight d) { return (long long)(d / this->delta); };
+       auto owner = [&](int u) { return unsigned(u / chunk); };
+
+       std::vector<std::vector<std::vector<int>>> buckets(T, std::vector<std::vector<int>>(nbBuckets));
+       std::vector<std::vector<std::vector<Request>>> requests(T, std::vector<std::vector<Request>>(T));
+
+       // Dernier seau où chaque sommet a été traité, pour ne le compter
+       // qu'une fois dans la phase des arcs lourds
+       std::vector<long long> settledIn(V, -1);
+
+       // Valeurs échangées entre threads à chaque barrière
+       std::vector<long long> nextBucket(T);
+       std::vector<char> hasWork(T);
+
+       this->edgeTo[v] = Edge(v, v, 0);
+       this->distanceTo[v] = 0;
+       buckets[owner(v)][0].push_back(v);
+
+       Barrier barrier(T);
+
+       parallelFor(T, int(T), [&](unsigned t, int, int) {
+          std::vector<int> frontier, settled;
+          std::vector<std::vector<int>>& myBuckets = buckets[t];
+          long long current = 0;
+
+          // Applique les requêtes destinées à t
+          auto applyRequests = [&]() {
+             for (unsigned s = 0; s < T; ++s) {
+                for (const Request& r : requests[s][t]) {
+                   int w = r.e.To();
+                   if (r.distance < this->distanceTo[w]) {
+                      this->distanceTo[w] = r.distance;
+                      this->edgeTo[w] = r.e;
+                      myBuckets[bucketOf(r.distance) % nbBuckets].push_back(w);
+                   }
+                }
+                requests[s][t].clear();
+             }
+          };
+
+          // Émet les relâchements des arcs légers (light) ou lourds de u
+          auto emit = [&](int u, bool light) {
+             Weight du = this->distanceTo[u];
+             g.forEachAdjacentEdge(u, [&](const Edge& e) {
+                if ((e.Weight() <= this->delta) == light) {
+                   Request r = {e, du + e.Weight()};
+                   requests[t][owner(e.To())].push_back(r);
+                }
+             });
+          };
+
+          while (true) {
+             // Prochain seau non vide, le plus petit sur tous les threads
+             nextBucket[t] = -1;
+             for (long long i = current; i < current + nbBuckets; ++i) {
+                if (!myBuckets[i % nbBuckets].empty()) {
+                   nextBucket[t] = i;
+                   break;
+                }
+             }
+             barrier.wait();
+
+             current = -1;
+             for (unsigned s = 0; s < T; ++s)
+                if (nextBucket[s] != -1 && (current == -1 || nextBucket[s] < current))
+                   current = nextBucket[s];
+             if (current == -1) break;
+
+             // Arcs légers, jusqu'à ce que le seau courant soit vide partout
+             settled.clear();
+             while (true) {
+                frontier.clear();
+                frontier.swap(myBuckets[current % nbBuckets]);
+
+                // On écarte les entrées périmées (sommet depuis rangé plus bas)
+                size_t n = 0;
+                for (int u : frontier) {
+                   if (bucketOf(this->distanceTo[u]) != current) continue;
+                   frontier[n++] = u;
+                   if (settledIn[u] != current) {
+                      settledIn[u] = current;
+                      settled.push_back(u);
+                   }
+                }
+                frontier.resize(n);
+
+                hasWork[t] = !frontier.empty();
+                barrier.wait();
+
+                bool any = false;
+                for (unsigned s = 0; s < T; ++s) any = any || hasWork[s];
+                if (!any) break;
+
+                for (int u : frontier) emit(u, true);
+                barrier.wait();
+                applyRequests();
+             }
+
+             // Arcs lourds des sommets sortis du seau courant
+             for (int u : settled) emit(u, false);
+             barrier.wait();
+             applyRequests();
+          }
+       });
+    }
+};
+
 
 #endif
@@ -8,11 +8,40 @@
 #ifndef UTIL_H
 #define	UTIL_H
 
-#include <vector>
+#include <cstddef>
 #include <string>
 
-std::vector<std::string> &split(const std::string &s, char delim, std::vector<std::string> &elems);
-std::vector<std::string> split(const std::string &s, char delim);
+// Champ d'une ligne: les caracteres [data, data + size), sans copie.
+// Il reste valide tant que le texte decoupe n'est pas modifie.
+struct StringToken {
+    const char* data;
+    size_t size;
+
+    bool empty() const { return size == 0; }
+    std::string str() const { return std::string(data, size); }
+};
+
+// Decoupe un texte selon delim en StringToken, sans allocation.
+// Comme avec std::getline, un delimiteur final n'ouvre pas de champ vide.
+class Tokenizer {
+public:
+    Tokenizer(const char* begin, const char* end, char delim);
+    Tokenizer(const std::string& line, char delim);
+
+    // Place le champ suivant dans token. Renvoie faux s'il n'y en a plus.
+    bool next(StringToken& token);
+
+private:
+    const char* pos;
+    const char* end;
+    char delim;
+};
+
+// Conversions d'un champ, comme std::stoi / std::stod mais sans
+// allocation ni exception. Renvoient faux si le champ ne commence pas
+// par un nombre.
+bool parseInt(const StringToken& token, int& value);
+bool parseDouble(const StringToken& token, double& value);
 
 #endif	/* UTIL_H */
 
@@ -9,9 +9,12 @@
 
 #include <iostream>
 #include <cmath>
+#include <cstdio>
 
 #include "ShortestPath.h"
 #include "GraphWeightedDirected.h"
+#include "GraphWeightedDirectedCSR.h"
+#include "Landmarks.h"
 
 using namespace std;
 
@@ -30,10 +33,46 @@ bool testMST(const string& filename) {
    //on execute les 2 algorithmes ShortestPath
    BellmanFordSP<Graph> referenceSP(ewd, 0);
    DijkstraSP<Graph> testSP(ewd, 0);
+   DijkstraSP<Graph, SetMinPQ<double>> testSetSP(ewd, 0);
+
+   // Dijkstra sur la représentation CSR du même graphe
+   typedef GraphWeightedDirectedCSR<double> GraphCSR;
+   GraphCSR csr(ewd);
+   DijkstraSP<GraphCSR> testCSR(csr, 0);
+
+   // Delta-stepping parallèle, sur tous les coeurs
+   DeltaSteppingSP<GraphCSR> testDelta(csr, 0);
+
+   // A* guidé par 8 repères, vers une centaine de destinations. Les repères
+   // relus après Save doivent donner exactement les mêmes minorants.
+   Landmarks<Graph> landmarks(ewd, 8);
+   const string fichierReperes = "reperes_test.bin";
+   landmarks.Save(fichierReperes);
+   Landmarks<Graph> reloaded(ewd, fichierReperes);
+   remove(fichierReperes.c_str());
+
+   if(reloaded.Vertices() != landmarks.Vertices())
+   {
+      return false;
+   }
+
+   for(int i = 1; i < ewd.V(); i += max(1, ewd.V() / 100))
+   {
+      AStarSP<Graph> testALT(ewd, 0, i, landmarks);
+      if(fabs(referenceSP.distanceToVertex(i) - testALT.distance()) > 0.000001 ||
+         reloaded.lowerBound(0, i) != landmarks.lowerBound(0, i) ||
+         reloaded.lowerBound(i, 0) != landmarks.lowerBound(i, 0))
+      {
+         return false;
+      }
+   }
 
    for(int i = 1; i < ewd.V(); ++i)
    {
-      if(fabs(referenceSP.distanceToVertex(i) - testSP.distanceToVertex(i)) > 0.000001)
+      if(fabs(referenceSP.distanceToVertex(i) - testSP.distanceToVertex(i)) > 0.000001 ||
+         fabs(referenceSP.distanceToVertex(i) - testSetSP.distanceToVertex(i)) > 0.000001 ||
+         fabs(referenceSP.distanceToVertex(i) - testCSR.distanceToVertex(i)) > 0.000001 ||
+         fabs(referenceSP.distanceToVertex(i) - testDelta.distanceToVertex(i)) > 0.000001)
       {
          return false;
       }
@@ -0,0 +1,759 @@
+/*
+ * File:   ContractionHierarchy.h
+ * Author: Berney Alec, Forestier Quentin, Herzig Melvyn
+ *
+ * Created on 17. octobre 2026
+ */
+
+#ifndef ASD2_ContractionHierarchy_h
+#define ASD2_ContractionHierarchy_h
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Parallel.h"
+#include "TrainGraphWrapper.h"
+
+/**
+ * @brief Hiérarchie de contraction (contraction hierarchy) d'un réseau
+ *        ferroviaire pour une fonction de coût donnée.
+ * @details Le prétraitement contracte les villes une à une, de la moins à la
+ *          plus importante. Contracter v revient à le retirer du graphe en
+ *          ajoutant un raccourci u -> w pour chaque chemin u -> v -> w qui n'a
+ *          pas de chemin témoin au moins aussi court évitant v. L'importance
+ *          d'une ville est sa différence d'arcs: raccourcis ajoutés moins arcs
+ *          retirés, plus le nombre de voisins déjà contractés pour étaler les
+ *          contractions sur tout le réseau.
+ *
+ *          Une requête fait une recherche bidirectionnelle qui ne suit que des
+ *          arcs montant vers des villes de rang supérieur. Les raccourcis du
+ *          chemin trouvé sont ensuite déroulés en lignes du TrainNetwork.
+ *
+ *          Le résultat du prétraitement peut être sauvé puis rechargé. Le
+ *          fichier porte le nombre de villes et deux empreintes FNV-1a, l'une
+ *          des couts des lignes, l'autre des arcs ouverts du graphe: il n'est
+ *          relu que pour le même réseau, avec la même fonction de coût et les
+ *          mêmes fermetures. Chaque indice lu est en outre vérifié.
+ */
+class ContractionHierarchy
+{
+public:
+   typedef double Weight;
+
+   // Itinéraire renvoyé par une requête
+   struct Route
+   {
+      // Coût total, numeric_limits<double>::max() si la destination est inaccessible
+      Weight distance;
+
+      // Villes successives, départ et arrivée comprises
+      std::vector<int> cities;
+
+      // Indices dans TrainNetwork::lines des lignes empruntées, dans l'ordre
+      std::vector<size_t> lines;
+   };
+
+private:
+
+   // Arc de la hiérarchie: soit issu d'une ligne, soit raccourci de deux arcs.
+   struct Arc
+   {
+      int from, to;
+      Weight weight;
+      long line;          // indice de la ligne, -1 pour un raccourci
+      int first, second;  // arcs from -> milieu et milieu -> to d'un raccourci
+   };
+
+   typedef std::pair<Weight, int> WeightVertex;
+   typedef std::vector<WeightVertex> Heap;
+
+   static Weight infinity ()
+   {
+      return std::numeric_limits<Weight>::max();
+   }
+
+   std::vector<Arc> arcs;
+
+   // Empreintes du graphe prétraité: couts des lignes et arcs ouverts
+   uint64_t costFingerprint, arcFingerprint;
+
+   // Ordre de contraction de chaque ville
+   std::vector<int> rank;
+
+   // Graphe de recherche, au format CSR.
+   // up   : arcs v -> w avec rank[w] > rank[v], rangés chez v.
+   // down : arcs w -> v avec rank[w] > rank[v], rangés chez v.
+   std::vector<int> upOffsets, upArcs;
+   std::vector<int> downOffsets, downArcs;
+
+   // Espace de travail des requêtes. Les cases modifiées sont notées dans
+   // touched et seules celles-ci sont remises à zéro.
+   mutable std::vector<Weight> distF, distB;
+   mutable std::vector<int> parentF, parentB;
+   mutable std::vector<int> touched;
+   mutable Heap heapF, heapB;
+
+   // Limite de sommets visités par une recherche de témoin. Au delà, on
+   // ajoute le raccourci par précaution.
+   static const int WITNESS_LIMIT = 500;
+
+   //------------------------------------------------------------------------
+   // Prétraitement
+
+   // Données utilisées uniquement pendant la contraction
+   struct Builder
+   {
+      std::vector<std::vector<int>> out, in;   // arcs des villes non contractées
+      std::vector<bool> contracted;
+      std::vector<int> deletedNeighbors;
+
+      // Espace de travail des recherches de témoin
+      std::vector<Weight> dist;
+      std::vector<int> touched;
+      Heap heap;
+   };
+
+   /**
+    * @brief Ajoute l'arc a, sauf s'il existe déjà un arc from -> to au moins
+    *        aussi court. Un arc plus long est remplacé.
+    * @details Un arc entre deux villes non contractées n'est sous-arc d'aucun
+    *          raccourci, il peut donc être remplacé sans risque.
+    */
+   void addArc (Builder &b, const Arc &a)
+   {
+      for (int i : b.out[a.from])
+      {
+         if (arcs[i].to == a.to)
+         {
+            if (a.weight < arcs[i].weight)
+               arcs[i] = a;
+            return;
+         }
+      }
+
+      b.out[a.from].push_back(int(arcs.size()));
+      b.in[a.to].push_back(int(arcs.size()));
+      arcs.push_back(a);
+   }
+
+   /**
+    * @brief Dijkstra depuis u dans le graphe des villes non contractées
+    *        privé de v, arrêté au-delà de maxDist ou de WITNESS_LIMIT sommets.
+    * @details Les distances trouvées restent dans b.dist jusqu'au prochain appel.
+    */
+   void witnessSearch (Builder &b, int u, int v, Weight maxDist) const
+   {
+      for (int x : b.touched) b.dist[x] = infinity();
+      b.touched.clear();
+      b.heap.clear();
+
+      b.dist[u] = 0;
+      b.touched.push_back(u);
+      b.heap.push_back(WeightVertex(0, u));
+
+      int settled = 0;
+      while (!b.heap.empty() && settled < WITNESS_LIMIT)
+      {
+         std::pop_heap(b.heap.begin(), b.heap.end(), std::greater<WeightVertex>());
+         WeightVertex top = b.heap.back();
+         b.heap.pop_back();
+
+         if (top.first > b.dist[top.second]) continue;   // entrée périmée
+         if (top.first > maxDist) break;
+         ++settled;
+
+         for (int i : b.out[top.second])
+         {
+            int w = arcs[i].to;
+            if (w == v || b.contracted[w]) continue;
+
+            Weight d = top.first + arcs[i].weight;
+            if (d < b.dist[w])
+            {
+               if (b.dist[w] == infinity()) b.touched.push_back(w);
+               b.dist[w] = d;
+               b.heap.push_back(WeightVertex(d, w));
+               std::push_heap(b.heap.begin(), b.heap.end(), std::greater<WeightVertex>());
+            }
+         }
+      }
+   }
+
+   /**
+    * @brief Calcule les raccourcis nécessaires pour contracter v.
+    * @param apply Si vrai, les raccourcis sont ajoutés, sinon seulement comptés.
+    * @return Nombre de raccourcis.
+    */
+   int contract (Builder &b, int v, bool apply)
+   {
+      int nbShortcuts = 0;
+
+      // copies: addArc peut modifier les listes de v
+      std::vector<int> inArcs = b.in[v], outArcs = b.out[v];
+
+      for (int a : inArcs)
+      {
+         int u = arcs[a].from;
+         if (b.contracted[u] || u == v) continue;
+
+         Weight maxDist = -1;
+         for (int c : outArcs)
+         {
+            if (!b.contracted[arcs[c].to] && arcs[c].to != u && arcs[c].to != v)
+               maxDist = std::max(maxDist, arcs[a].weight + arcs[c].weight);
+         }
+         if (maxDist < 0) continue;   // aucun voisin sortant à relier
+
+         witnessSearch(b, u, v, maxDist);
+
+         for (int c : outArcs)
+         {
+            int w = arcs[c].to;
+            if (b.contracted[w] || w == u || w == v) continue;
+
+            Weight via = arcs[a].weight + arcs[c].weight;
+            if (b.dist[w] > via)
+            {
+               ++nbShortcuts;
+               if (apply)
+               {
+                  Arc shortcut = {u, w, via, -1, a, c};
+                  addArc(b, shortcut);
+               }
+            }
+         }
+      }
+
+      return nbShortcuts;
+   }
+
+   // Différence d'arcs de v, plus ses voisins déjà contractés
+   int priority (Builder &b, int v)
+   {
+      int degree = 0;
+      for (int a : b.in[v])  if (!b.contracted[arcs[a].from]) ++degree;
+      for (int a : b.out[v]) if (!b.contracted[arcs[a].to])   ++degree;
+
+      return contract(b, v, false) - degree + b.deletedNeighbors[v];
+   }
+
+   //------------------------------------------------------------------------
+   // Empreintes et vérification des fichiers
+
+   // Ajoute size octets de data à l'empreinte FNV-1a hash
+   static void mix (uint64_t &hash, const void *data, size_t size)
+   {
+      const unsigned char *bytes = static_cast<const unsigned char *>(data);
+      for (size_t i = 0; i < size; ++i)
+      {
+         hash ^= bytes[i];
+         hash *= 1099511628211ULL;
+      }
+   }
+
+   // Empreinte des couts de toutes les lignes de g, qui identifie sa fonction de coût
+   static uint64_t costFingerprintOf (const TrainGraphWrapperDirected &g)
+   {
+      uint64_t hash = 14695981039346656037ULL;
+      for (size_t i = 0; i < g.nbLines(); ++i)
+      {
+         Weight cost = g.cost(i);
+         mix(hash, &cost, sizeof(cost));
+      }
+      return hash;
+   }
+
+   // Empreinte de V et des arcs ouverts de g (extrémités et ligne)
+   static uint64_t arcFingerprintOf (const TrainGraphWrapperDirected &g)
+   {
+      uint64_t hash = 14695981039346656037ULL;
+      int V = g.V();
+      mix(hash, &V, sizeof(V));
+      for (int v = 0; v < V; ++v)
+      {
+         g.forEachAdjacentLine(v, [&] (const EdgeWeightedDirected<Weight> &e, size_t line)
+         {
+            int from = e.From(), to = e.To();
+            uint64_t l = line;
+            mix(hash, &from, sizeof(from));
+            mix(hash, &to, sizeof(to));
+            mix(hash, &l, sizeof(l));
+         });
+      }
+      return hash;
+   }
+
+   /**
+    * @brief Vérifie que rank et arcs, lus dans un fichier, sont utilisables
+    *        avec g.
+    * @throws std::runtime_error sinon.
+    * @details rank doit être une permutation de [0, V). Chaque arc issu d'une
+    *          ligne doit exister dans g avec le même coût. Un raccourci doit
+    *          être la concaténation de ses deux sous-arcs, dont la ville du
+    *          milieu est de rang inférieur à ses deux extrémités: le
+    *          déroulement des raccourcis termine donc toujours.
+    */
+   void validate (const TrainGraphWrapperDirected &g, const std::string &filename) const
+   {
+      const std::string error = "ContractionHierarchy : fichier invalide " + filename;
+      int V = int(rank.size());
+      long nbArcs = long(arcs.size());
+
+      std::vector<bool> seen(V, false);
+      for (int r : rank)
+      {
+         if (r < 0 || r >= V || seen[r]) throw std::runtime_error(error);
+         seen[r] = true;
+      }
+
+      for (const Arc &a : arcs)
+         if (a.from < 0 || a.from >= V || a.to < 0 || a.to >= V || !(a.weight >= 0))
+            throw std::runtime_error(error);
+
+      for (const Arc &a : arcs)
+      {
+         if (a.line == -1)
+         {
+            if (a.first < 0 || a.first >= nbArcs || a.second < 0 || a.second >= nbArcs)
+               throw std::runtime_error(error);
+
+            const Arc &x = arcs[a.first], &y = arcs[a.second];
+            int middle = x.to;
+            if (x.from != a.from || y.from != middle || y.to != a.to || x.weight + y.weight != a.weight ||
+                rank[middle] >= rank[a.from] || rank[middle] >= rank[a.to])
+               throw std::runtime_error(error);
+         }
+         else
+         {
+            if (a.line < 0 || size_t(a.line) >= g.nbLines())
+               throw std::runtime_error(error);
+
+            bool found = false;
+            g.forEachAdjacentLine(a.from, [&] (const EdgeWeightedDirected<Weight> &e, size_t line)
+            {
+               if (e.To() == a.to && long(line) == a.line && e.Weight() == a.weight) found = true;
+            });
+            if (!found) throw std::runtime_error(error);
+         }
+      }
+   }
+
+   //------------------------------------------------------------------------
+   // Requêtes
+
+   // Construit les graphes de recherche up et down à partir de arcs et rank.
+   void buildSearchGraph ()
+   {
+      int V = int(rank.size());
+      upOffsets.assign(V + 1, 0);
+      downOffsets.assign(V + 1, 0);
+
+      for (const Arc &a : arcs)
+      {
+         if (rank[a.from] < rank[a.to]) ++upOffsets[a.from + 1];
+         else                           ++downOffsets[a.to + 1];
+      }
+      for (int v = 0; v < V; ++v)
+      {
+         upOffsets[v + 1] += upOffsets[v];
+         downOffsets[v + 1] += downOffsets[v];
+      }
+
+      upArcs.resize(upOffsets.back());
+      downArcs.resize(downOffsets.back());
+      std::vector<int> nextUp(upOffsets.begin(), upOffsets.end() - 1);
+      std::vector<int> nextDown(downOffsets.begin(), downOffsets.end() - 1);
+
+      for (int i = 0; i < int(arcs.size()); ++i)
+      {
+         if (rank[arcs[i].from] < rank[arcs[i].to]) upArcs[nextUp[arcs[i].from]++] = i;
+         else                                       downArcs[nextDown[arcs[i].to]++] = i;
+      }
+
+      distF.assign(V, infinity());
+      distB.assign(V, infinity());
+      parentF.assign(V, -1);
+      parentB.assign(V, -1);
+   }
+
+   // Ajoute à route les lignes et villes de l'arc a, raccourcis déroulés
+   void unpack (int a, Route &route) const
+   {
+      if (arcs[a].line == -1)
+      {
+         unpack(arcs[a].first, route);
+         unpack(arcs[a].second, route);
+      }
+      else
+      {
+         route.lines.push_back(size_t(arcs[a].line));
+         route.cities.push_back(arcs[a].to);
+      }
+   }
+
+   // Relâche l'arc a dans une des deux recherches
+   void relax (int a, int from, int to, std::vector<Weight> &dist,
+               std::vector<int> &parent, Heap &heap) const
+   {
+      Weight d = dist[from] + arcs[a].weight;
+      if (d < dist[to])
+      {
+         if (distF[to] == infinity() && distB[to] == infinity()) touched.push_back(to);
+         dist[to] = d;
+         parent[to] = a;
+         heap.push_back(WeightVertex(d, to));
+         std::push_heap(heap.begin(), heap.end(), std::greater<WeightVertex>());
+      }
+   }
+
+   /**
+    * @brief Recherche complète dans le graphe montant depuis s: par les arcs
+    *        up si forward, sinon à rebours par les arcs down.
+    * @param settled Reçoit chaque sommet atteint avec sa distance finale.
+    * @details N'utilise que l'espace de travail passé en paramètre, plusieurs
+    *          recherches peuvent donc avoir lieu en même temps.
+    */
+   void upwardSearch (int s, bool forward, std::vector<Weight> &dist, std::vector<int> &visited,
+                      Heap &heap, std::vector<WeightVertex> &settled) const
+   {
+      for (int v : visited) dist[v] = infinity();
+      visited.clear();
+      heap.clear();
+      settled.clear();
+
+      dist[s] = 0;
+      visited.push_back(s);
+      heap.push_back(WeightVertex(0, s));
+
+      while (!heap.empty())
+      {
+         std::pop_heap(heap.begin(), heap.end(), std::greater<WeightVertex>());
+         WeightVertex top = heap.back();
+         heap.pop_back();
+
+         int v = top.second;
+         if (top.first > dist[v]) continue;
+         settled.push_back(top);
+
+         const std::vector<int> &offsets = forward ? upOffsets : downOffsets;
+         const std::vector<int> &search  = forward ? upArcs : downArcs;
+         for (int i = offsets[v]; i < offsets[v + 1]; ++i)
+         {
+            const Arc &a = arcs[search[i]];
+            int w = forward ? a.to : a.from;
+            Weight d = top.first + a.weight;
+            if (d < dist[w])
+            {
+               if (dist[w] == infinity()) visited.push_back(w);
+               dist[w] = d;
+               heap.push_back(WeightVertex(d, w));
+               std::push_heap(heap.begin(), heap.end(), std::greater<WeightVertex>());
+            }
+         }
+      }
+   }
+
+public:
+
+   /**
+    * @brief Prétraitement du réseau de g pour le coût de g.
+    * @param g Réseau ferroviaire et fonction de coût, non négative.
+    */
+   explicit ContractionHierarchy (const TrainGraphWrapperDirected &g)
+           : costFingerprint(costFingerprintOf(g)), arcFingerprint(arcFingerprintOf(g))
+   {
+      int V = g.V();
+      Builder b;
+      b.out.resize(V);
+      b.in.resize(V);
+      b.contracted.assign(V, false);
+      b.deletedNeighbors.assign(V, 0);
+      b.dist.assign(V, infinity());
+
+      for (int v = 0; v < V; ++v)
+      {
+         g.forEachAdjacentLine(v, [&] (const EdgeWeightedDirected<Weight> &e, size_t line)
+         {
+            Arc a = {e.From(), e.To(), e.Weight(), long(line), -1, -1};
+            addArc(b, a);
+         });
+      }
+
+      // File des villes par priorité croissante, mise à jour paresseusement:
+      // la priorité d'une ville n'est recalculée que lorsqu'elle sort de la file.
+      typedef std::pair<int, int> PriorityVertex;
+      std::priority_queue<PriorityVertex, std::vector<PriorityVertex>, std::greater<PriorityVertex>> pq;
+      for (int v = 0; v < V; ++v)
+         pq.push(PriorityVertex(priority(b, v), v));
+
+      rank.assign(V, -1);
+      int next = 0;
+      while (!pq.empty())
+      {
+         int v = pq.top().second;
+         pq.pop();
+         if (b.contracted[v]) continue;
+
+         int p = priority(b, v);
+         if (!pq.empty() && p > pq.top().first)
+         {
+            pq.push(PriorityVertex(p, v));
+            continue;
+         }
+
+         contract(b, v, true);
+         b.contracted[v] = true;
+         rank[v] = next++;
+
+         for (int a : b.in[v])  ++b.deletedNeighbors[arcs[a].from];
+         for (int a : b.out[v]) ++b.deletedNeighbors[arcs[a].to];
+      }
+
+      buildSearchGraph();
+   }
+
+   /**
+    * @brief Charge une hiérarchie écrite par Save.
+    * @param g Réseau, fonction de coût et fermetures avec lesquels la
+    *        hiérarchie a été calculée.
+    * @param filename Nom du fichier.
+    * @throws std::runtime_error si le fichier est absent, invalide, ou calculé
+    *         pour un autre graphe ou une autre fonction de coût.
+    */
+   ContractionHierarchy (const TrainGraphWrapperDirected &g, const std::string &filename)
+           : costFingerprint(costFingerprintOf(g)), arcFingerprint(arcFingerprintOf(g))
+   {
+      std::ifstream s(filename);
+      std::string magic;
+      int version, V;
+      long nbArcs;
+      uint64_t costs, arcsRead;
+
+      if (!(s >> magic >> version) || magic != "ASD2-CH" || version != 2)
+         throw std::runtime_error("ContractionHierarchy : format inconnu " + filename);
+      if (!(s >> V >> nbArcs >> costs >> arcsRead) || V < 0 || nbArcs < 0)
+         throw std::runtime_error("ContractionHierarchy : en-tete invalide " + filename);
+      if (V != g.V() || arcsRead != arcFingerprint)
+         throw std::runtime_error("ContractionHierarchy : fichier calcule sur un autre graphe " + filename);
+      if (costs != costFingerprint)
+         throw std::runtime_error("ContractionHierarchy : fichier calcule pour une autre fonction de cout " + filename);
+
+      rank.resize(V);
+      for (int &r : rank)
+         s >> r;
+
+      // addArc garde au plus un arc par couple de villes
+      if (nbArcs > long(V) * V)
+         throw std::runtime_error("ContractionHierarchy : en-tete invalide " + filename);
+      arcs.resize(nbArcs);
+      for (Arc &a : arcs)
+         s >> a.from >> a.to >> a.weight >> a.line >> a.first >> a.second;
+
+      if (!s)
+         throw std::runtime_error("ContractionHierarchy : fichier tronque " + filename);
+
+      validate(g, filename);
+      buildSearchGraph();
+   }
+
+   /**
+    * @brief Ecrit la hiérarchie dans un fichier texte.
+    * @param filename Nom du fichier.
+    */
+   void Save (const std::string &filename) const
+   {
+      std::ofstream s(filename);
+      s << "ASD2-CH 2\n" << rank.size() << " " << arcs.size() << " "
+        << costFingerprint << " " << arcFingerprint << "\n";
+
+      for (int r : rank)
+         s << r << "\n";
+
+      s << std::setprecision(17);
+      for (const Arc &a : arcs)
+         s << a.from << " " << a.to << " " << a.weight << " " << a.line << " "
+           << a.first << " " << a.second << "\n";
+
+      if (!s)
+         throw std::runtime_error("ContractionHierarchy : erreur d'ecriture " + filename);
+   }
+
+   // Nombre de raccourcis ajoutés par le prétraitement
+   size_t nbShortcuts () const
+   {
+      size_t n = 0;
+      for (const Arc &a : arcs)
+         if (a.line == -1) ++n;
+      return n;
+   }
+
+   /**
+    * @brief Plus court chemin de la ville s à la ville t.
+    * @return Coût, villes et lignes de l'itinéraire.
+    * @details Utilise l'espace de travail de l'objet: deux requêtes ne doivent
+    *          pas être faites en même temps sur la même hiérarchie.
+    */
+   Route query (int s, int t) const
+   {
+      for (int v : touched)
+      {
+         distF[v] = distB[v] = infinity();
+         parentF[v] = parentB[v] = -1;
+      }
+      touched.clear();
+      heapF.clear();
+      heapB.clear();
+
+      distF[s] = 0;
+      distB[t] = 0;
+      touched.push_back(s);
+      if (t != s) touched.push_back(t);
+      heapF.push_back(WeightVertex(0, s));
+      heapB.push_back(WeightVertex(0, t));
+
+      Weight mu = s == t ? 0 : infinity();
+      int meet = s == t ? s : -1;
+
+      // Chaque recherche s'arrête dès que sa plus petite clé atteint mu.
+      while (!heapF.empty() || !heapB.empty())
+      {
+         bool forward = heapB.empty() || (!heapF.empty() && heapF.front().first <= heapB.front().first);
+         Heap &heap = forward ? heapF : heapB;
+
+         std::pop_heap(heap.begin(), heap.end(), std::greater<WeightVertex>());
+         WeightVertex top = heap.back();
+         heap.pop_back();
+
+         if (top.first >= mu)
+         {
+            heap.clear();
+            continue;
+         }
+
+         int v = top.second;
+         if (forward)
+         {
+            if (top.first > distF[v]) continue;
+            for (int i = upOffsets[v]; i < upOffsets[v + 1]; ++i)
+               relax(upArcs[i], v, arcs[upArcs[i]].to, distF, parentF, heapF);
+         }
+         else
+         {
+            if (top.first > distB[v]) continue;
+            for (int i = downOffsets[v]; i < downOffsets[v + 1]; ++i)
+               relax(downArcs[i], v, arcs[downArcs[i]].from, distB, parentB, heapB);
+         }
+
+         if (distF[v] != infinity() && distB[v] != infinity() && distF[v] + distB[v] < mu)
+         {
+            mu = distF[v] + distB[v];
+            meet = v;
+         }
+      }
+
+      Route route;
+      route.distance = mu;
+      if (meet == -1) return route;
+
+      // arcs montants de s jusqu'au sommet de rencontre, puis descendants jusqu'à t
+      std::vector<int> path;
+      for (int v = meet; parentF[v] != -1; v = arcs[parentF[v]].from)
+         path.push_back(parentF[v]);
+      std::reverse(path.begin(), path.end());
+      for (int v = meet; parentB[v] != -1; v = arcs[parentB[v]].to)
+         path.push_back(parentB[v]);
+
+      route.cities.push_back(s);
+      for (int a : path)
+         unpack(a, route);
+
+      return route;
+   }
+   /**
+    * @brief Table des distances de chaque source à chaque destination.
+    * @param sources Villes de départ, une par ligne.
+    * @param targets Villes d'arrivée, une par colonne.
+    * @param nbThreads Nombre de threads, 0 pour utiliser tous les coeurs.
+    * @return Matrice ligne par ligne: case i * targets.size() + j pour le
+    *         trajet de sources[i] à targets[j], numeric_limits<double>::max()
+    *         s'il est impossible.
+    * @details Méthode des seaux: une recherche montante à rebours depuis chaque
+    *          destination dépose (colonne, distance) dans le seau de chaque
+    *          ville atteinte. Une recherche montante depuis chaque source
+    *          combine ensuite sa distance à chaque ville avec le contenu du
+    *          seau. Chaque phase est répartie entre les threads. Contrairement
+    *          à query, plusieurs appels peuvent avoir lieu en même temps.
+    */
+   std::vector<Weight> table (const std::vector<int> &sources, const std::vector<int> &targets,
+                              unsigned nbThreads = 0) const
+   {
+      int V = int(rank.size());
+      size_t nbCols = targets.size();
+      std::vector<Weight> matrix(sources.size() * nbCols, infinity());
+      if (matrix.empty()) return matrix;
+
+      nbThreads = threadCount(nbThreads);
+
+      // Recherches à rebours, une par destination
+      std::vector<std::vector<WeightVertex>> reached(nbCols);
+      parallelFor(std::min(nbThreads, unsigned(nbCols)), int(nbCols), [&] (unsigned, int begin, int end)
+      {
+         std::vector<Weight> dist(V, infinity());
+         std::vector<int> visited;
+         Heap heap;
+         for (int j = begin; j < end; ++j)
+            upwardSearch(targets[j], false, dist, visited, heap, reached[j]);
+      });
+
+      // Seaux au format CSR: (colonne, distance) par ville
+      typedef std::pair<int, Weight> Bucket;
+      std::vector<int> bucketOffsets(V + 1, 0);
+      for (const std::vector<WeightVertex> &r : reached)
+         for (const WeightVertex &wv : r) ++bucketOffsets[wv.second + 1];
+      for (int v = 0; v < V; ++v) bucketOffsets[v + 1] += bucketOffsets[v];
+
+      std::vector<Bucket> buckets(bucketOffsets[V]);
+      std::vector<int> fill(bucketOffsets.begin(), bucketOffsets.end() - 1);
+      for (size_t j = 0; j < nbCols; ++j)
+      {
+         for (const WeightVertex &wv : reached[j])
+            buckets[fill[wv.second]++] = Bucket(int(j), wv.first);
+         std::vector<WeightVertex>().swap(reached[j]);
+      }
+
+      // Recherches montantes, une par source
+      parallelFor(std::min(nbThreads, unsigned(sources.size())), int(sources.size()), [&] (unsigned, int begin, int end)
+      {
+         std::vector<Weight> dist(V, infinity());
+         std::vector<int> visited;
+         Heap heap;
+         std::vector<WeightVertex> settled;
+         for (int i = begin; i < end; ++i)
+         {
+            upwardSearch(sources[i], true, dist, visited, heap, settled);
+            Weight *row = &matrix[i * nbCols];
+            for (const WeightVertex &wv : settled)
+            {
+               for (int k = bucketOffsets[wv.second]; k < bucketOffsets[wv.second + 1]; ++k)
+               {
+                  Weight d = wv.first + buckets[k].second;
+                  if (d < row[buckets[k].first]) row[buckets[k].first] = d;
+               }
+            }
+         }
+      });
+
+      return matrix;
+   }
+};
+
+#endif
@@ -0,0 +1,183 @@
+/*
+ * File:   ParetoSearch.h
+ * Author: Berney Alec, Forestier Quentin, Herzig Melvyn
+ *
+ * Created on 17. octobre 2026
+ */
+
+#ifndef ASD2_ParetoSearch_h
+#define ASD2_ParetoSearch_h
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <vector>
+
+#include "TrainNetwork.h"
+
+/**
+ * @brief Recherche multicritère des itinéraires Pareto-optimaux entre deux
+ *        villes d'un réseau ferroviaire.
+ * @details Les critères sont la longueur et la durée, à minimiser, ainsi que
+ *          le plus petit nombre de voies des lignes empruntées, à maximiser.
+ *          Un itinéraire est Pareto-optimal si aucun autre n'est au moins aussi
+ *          bon sur les trois critères.
+ *
+ *          Recherche à étiquettes (Martins): chaque étiquette est un
+ *          itinéraire partiel. Elles sont traitées dans l'ordre lexicographique
+ *          (longueur, durée, -voies), si bien qu'une étiquette retirée de la
+ *          file ne peut plus être dominée par une étiquette future. Une
+ *          étiquette dominée par une étiquette déjà fixée dans la même ville,
+ *          ou à l'arrivée, est abandonnée.
+ *
+ *          Le nombre d'étiquettes fixées par ville est borné par maxLabels.
+ *          Une fois la borne atteinte, les nouvelles étiquettes de la ville
+ *          sont ignorées: le front obtenu peut alors être incomplet, mais
+ *          chacun de ses itinéraires reste non dominé par les autres.
+ */
+class ParetoSearch
+{
+public:
+
+   // Itinéraire du front de Pareto
+   struct Route
+   {
+      double length;
+      double duration;
+
+      // Plus petit nombre de voies des lignes empruntées,
+      // numeric_limits<size_t>::max() si l'itinéraire est vide
+      size_t nbTracks;
+
+      // Villes successives, départ et arrivée comprises
+      std::vector<int> cities;
+
+      // Indices dans TrainNetwork::lines des lignes empruntées, dans l'ordre
+      std::vector<size_t> lines;
+   };
+
+private:
+
+   struct Label
+   {
+      double length;
+      double duration;
+      size_t nbTracks;
+      int city;
+      int parent;    // étiquette précédente, -1 au départ
+      size_t line;   // ligne empruntée depuis parent
+   };
+
+   std::vector<Label> labels;
+
+   // Étiquettes fixées de chaque ville
+   std::vector<std::vector<int>> settled;
+
+   std::vector<Route> front;
+
+   // Vrai si a est au moins aussi bonne que b sur les trois critères
+   static bool dominates (const Label &a, const Label &b)
+   {
+      return a.length <= b.length && a.duration <= b.duration && a.nbTracks >= b.nbTracks;
+   }
+
+   bool dominatedIn (const Label &l, int city) const
+   {
+      for (int i : settled[city])
+         if (dominates(labels[i], l)) return true;
+      return false;
+   }
+
+   // Ordre de traitement des étiquettes: lexicographique, la plus petite en tête
+   struct Later
+   {
+      const std::vector<Label> *labels;
+
+      bool operator() (int a, int b) const
+      {
+         const Label &x = (*labels)[a], &y = (*labels)[b];
+         if (x.length != y.length) return x.length > y.length;
+         if (x.duration != y.duration) return x.duration > y.duration;
+         return x.nbTracks < y.nbTracks;
+      }
+   };
+
+   Route makeRoute (int label) const
+   {
+      Route route;
+      route.length = labels[label].length;
+      route.duration = labels[label].duration;
+      route.nbTracks = labels[label].nbTracks;
+
+      for (int i = label; i != -1; i = labels[i].parent)
+      {
+         route.cities.push_back(labels[i].city);
+         if (labels[i].parent != -1) route.lines.push_back(labels[i].line);
+      }
+      std::reverse(route.cities.begin(), route.cities.end());
+      std::reverse(route.lines.begin(), route.lines.end());
+      return route;
+   }
+
+public:
+
+   /**
+    * @brief Calcule le front de Pareto des itinéraires de from à to.
+    * @param tn Réseau ferroviaire.
+    * @param from Numéro de la ville de départ.
+    * @param to Numéro de la ville d'arrivée.
+    * @param maxLabels Nombre maximal d'étiquettes fixées par ville.
+    */
+   ParetoSearch (const TrainNetwork &tn, int from, int to, size_t maxLabels = 64)
+           : settled(tn.cities.size())
+   {
+      Label start = {0, 0, std::numeric_limits<size_t>::max(), from, -1, 0};
+      labels.push_back(start);
+
+      std::priority_queue<int, std::vector<int>, Later> queue(Later{&labels});
+      queue.push(0);
+
+      while (!queue.empty())
+      {
+         int i = queue.top();
+         queue.pop();
+         Label l = labels[i];
+
+         if (settled[l.city].size() >= maxLabels || dominatedIn(l, l.city) || dominatedIn(l, to))
+            continue;
+         settled[l.city].push_back(i);
+
+         if (l.city == to)
+         {
+            front.push_back(makeRoute(i));
+            continue;   // prolonger un itinéraire complet ne peut que le dégrader
+         }
+
+         for (size_t lineIdx : tn.cities[l.city].lines)
+         {
+            const TrainNetwork::Line &line = tn.lines[lineIdx];
+            Label next = {l.length + line.length,
+                          l.duration + line.duration,
+                          std::min(l.nbTracks, line.nbTracks),
+                          line.cities.first == l.city ? line.cities.second : line.cities.first,
+                          i, lineIdx};
+
+            if (dominatedIn(next, next.city) || dominatedIn(next, to)) continue;
+
+            labels.push_back(next);
+            queue.push(int(labels.size()) - 1);
+         }
+      }
+   }
+
+   /**
+    * @brief Itinéraires Pareto-optimaux, par longueur croissante.
+    * @details Vide si l'arrivée est inaccessible.
+    */
+   const std::vector<Route> &Front () const
+   {
+      return front;
+   }
+};
+
+#endif
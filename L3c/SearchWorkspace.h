@@ -0,0 +1,114 @@
+/*
+ * File:   SearchWorkspace.h
+ * Author: Berney Alec, Forestier Quentin, Herzig Melvyn
+ *
+ * Created on 17. octobre 2026
+ */
+
+#ifndef ASD2_SearchWorkspace_h
+#define ASD2_SearchWorkspace_h
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "EdgeWeightedDirected.h"
+#include "IndexMinPQ.h"
+
+/**
+ * @brief Tableaux d'une recherche de plus court chemin (distances, arcs et
+ *        file de priorité), réutilisables d'une requête à l'autre.
+ * @details Chaque case porte le numéro de la requête qui l'a écrite. reset()
+ *          passe à la requête suivante en incrémentant ce numéro: les cases
+ *          écrites auparavant redeviennent « non atteintes » sans être
+ *          effacées, et seule la file est vidée, en temps proportionnel à son
+ *          contenu. Une suite de courtes requêtes sur un grand graphe ne paie
+ *          donc ni allocation ni remise à zéro en O(V).
+ *
+ *          Un espace de travail ne sert qu'à une recherche à la fois; les
+ *          résultats d'une recherche ne sont valides que jusqu'au reset()
+ *          suivant.
+ */
+class SearchWorkspace
+{
+public:
+   typedef double Weight;
+   typedef EdgeWeightedDirected<Weight> Edge;
+
+private:
+   std::vector<Weight> dist;
+   std::vector<Edge> edges;
+
+   // stamps[v] == current si v a été atteint par la requête courante
+   std::vector<unsigned> stamps;
+   unsigned current;
+
+   IndexMinPQ<Weight> pq;
+
+public:
+
+   /**
+    * @brief Construit un espace de travail pour des graphes à V sommets.
+    * @details La taille est de toute façon ajustée par reset().
+    */
+   explicit SearchWorkspace (int V = 0) : dist(V), edges(V), stamps(V, 0), current(0), pq(V)
+   {}
+
+   /**
+    * @brief Prépare une nouvelle requête sur un graphe à V sommets.
+    * @details Les tableaux ne sont réalloués que si V change. Lorsque le
+    *          numéro de requête fait le tour, les marques sont remises à zéro.
+    */
+   void reset (int V)
+   {
+      if (V != int(stamps.size()))
+      {
+         dist.assign(V, 0);
+         edges.assign(V, Edge());
+         stamps.assign(V, 0);
+         pq = IndexMinPQ<Weight>(V);
+         current = 0;
+      }
+      pq.clear();
+
+      if (++current == 0)
+      {
+         std::fill(stamps.begin(), stamps.end(), 0);
+         current = 1;
+      }
+   }
+
+   // Indique si v a été atteint depuis le dernier reset()
+   bool reached (int v) const
+   {
+      return stamps[v] == current;
+   }
+
+   // Distance de v, numeric_limits<double>::max() s'il n'a pas été atteint
+   Weight distance (int v) const
+   {
+      return reached(v) ? dist[v] : std::numeric_limits<Weight>::max();
+   }
+
+   // Arc par lequel v a été atteint, à n'appeler que si reached(v)
+   const Edge &edgeTo (int v) const
+   {
+      return edges[v];
+   }
+
+   // Enregistre que v est atteint à distance d par l'arc e
+   void update (int v, Weight d, const Edge &e)
+   {
+      dist[v] = d;
+      edges[v] = e;
+      stamps[v] = current;
+   }
+
+   // File de priorité de la requête courante, vide après reset()
+   IndexMinPQ<Weight> &queue ()
+   {
+      return pq;
+   }
+};
+
+#endif
@@ -10,11 +10,17 @@
 #define ASD2_ShortestPath_h
 
 #include <algorithm>
+#include <atomic>
 #include <queue>
 #include <vector>
 #include <set>
 #include <functional>
+#include <list>
+#include <limits>
 #include "EdgeWeightedDirected.h"
+#include "IndexMinPQ.h"
+#include "Parallel.h"
+#include "SearchWorkspace.h"
 
 // Classe parente de toutes les classes de plus court chemin.
 // Defini les membres edgeTo et distanceTo commun à toutes ces
@@ -59,6 +65,17 @@ public:
    Edges PathTo (int v)
    {
       Edges result;
+      PathTo(v, result);
+      return result;
+   }
+
+   /**
+    * @brief Remplace le contenu de result par les arcs du chemin de s à v,
+    *        ce qui évite une allocation si result a déjà servi.
+    */
+   void PathTo (int v, Edges &result)
+   {
+      result.clear();
       int dest = v;
       Edge e;
 
@@ -75,13 +92,56 @@ public:
       } while (e.From() != e.To());
 
       std::reverse(result.begin(), result.end());
-
-      return result;
    }
 
 protected:
    Edges edgeTo;
    Weights distanceTo;
+
+   /**
+    * @brief Cherche un cycle dans le graphe des edgeTo.
+    * @param source Source des plus courts chemins.
+    * @return Arcs du cycle dans l'ordre de parcours, vide s'il n'y en a pas.
+    * @details Chaque sommet atteint est visité une seule fois: on remonte ses
+    *          edgeTo jusqu'à la source ou jusqu'à un sommet déjà traité. Si on
+    *          retombe sur un sommet de la remontée en cours, c'est un cycle.
+    *          Un tel cycle est toujours un circuit absorbant.
+    */
+   std::list<Edge> edgeToCycle (int source) const
+   {
+      std::list<Edge> cycle;
+      int V = int(distanceTo.size());
+      std::vector<int> visitedBy(V, -1);
+
+      // La source n'est une racine que tant qu'elle n'a pas été relâchée.
+      int root = distanceTo[source] == 0 ? source : -1;
+
+      for (int s = 0; s < V; ++s)
+      {
+         if (visitedBy[s] != -1 || distanceTo[s] == std::numeric_limits<Weight>::max())
+            continue;
+
+         int v = s;
+         while (v != root && visitedBy[v] == -1)
+         {
+            visitedBy[v] = s;
+            v = edgeTo[v].From();
+         }
+
+         if (v != root && visitedBy[v] == s)
+         {
+            // v est sur le cycle, on en fait le tour
+            int u = v;
+            do
+            {
+               cycle.push_front(edgeTo[u]);
+               u = edgeTo[u].From();
+            } while (u != v);
+            break;
+         }
+      }
+      return cycle;
+   }
 };
 
 // Algorithme de BellmanFord.
@@ -101,8 +161,8 @@ private:
    typedef typename BASE::Edge Edge;
    typedef typename BASE::Weight Weight;
 
-   // Relachement de l'arc e
-   void relax (const Edge &e)
+   // Relachement de l'arc e. Renvoie vrai si distanceTo a diminue.
+   bool relax (const Edge &e)
    {
       int v = e.From(), w = e.To();
       Weight distThruE = this->distanceTo[v] + e.Weight();
@@ -111,13 +171,15 @@ private:
       {
          this->distanceTo[w] = distThruE;
          this->edgeTo[w] = e;
+         return true;
       }
+      return false;
    }
 
 public:
 
    // Constructeur a partir du graphe g et du sommet v a la source
-   // des plus courts chemins
+   // des plus courts chemins. S'arrete des qu'une passe ne relache aucun arc.
    BellmanFordSP (const GraphType &g, int v)
    {
       this->edgeTo.resize(g.V());
@@ -126,14 +188,723 @@ public:
       this->edgeTo[v] = Edge(v, v, 0);
       this->distanceTo[v] = 0;
 
-      for (int i = 0; i < g.V() - 1; ++i)
+      bool changed = true;
+      for (int i = 0; i < g.V() - 1 && changed; ++i)
       {
-         g.forEachEdge([this] (const Edge & e)
+         changed = false;
+         g.forEachEdge([this, &changed] (const Edge &e)
                        {
-                          this->relax(e);
+                          if (this->relax(e)) changed = true;
                        });
       }
    }
 };
 
+/**
+ * @brief Algorithme de BellmanFord à base de file (SPFA).
+ * @tparam GraphType Type du graphe pondéré orienté à traiter.
+ * @details GraphType doit se comporter comme un GraphWeightedDirected et
+ *          définir V() et forEachAdjacentEdge(int, Func), ainsi que le type
+ *          GraphType::Edge. Ce dernier doit se comporter comme
+ *          EdgeWeightedDirected, c-a-d définir From(), To() et Weight().
+ *
+ *          Seuls les arcs sortant des sommets dont la distance a changé sont
+ *          relâchés à nouveau. Tous les V relâchements réussis, on cherche un
+ *          cycle dans le graphe des edgeTo: s'il y en a un, c'est un circuit
+ *          absorbant et le calcul s'arrête.
+ */
+template<typename GraphType>
+class BellmanFordQueueSP : public ShortestPath<GraphType>
+{
+   typedef ShortestPath<GraphType> BASE;
+   typedef typename BASE::Edge Edge;
+   typedef typename BASE::Weight Weight;
+
+   // Sommets dont les arcs sortants doivent être relâchés.
+   std::queue<int> queue;
+   std::vector<bool> onQueue;
+
+   // Nombre de relâchements réussis depuis le début.
+   long long nbRelaxations;
+
+   // Circuit absorbant trouvé, vide s'il n'y en a pas.
+   std::list<Edge> cycle;
+
+   int source;
+
+   /**
+    * @brief Relâche l'arc e et place son extrémité dans la file si sa distance
+    *        diminue.
+    */
+   void relax (const Edge &e)
+   {
+      int v = e.From(), w = e.To();
+      Weight distThruE = this->distanceTo[v] + e.Weight();
+
+      if (this->distanceTo[w] > distThruE)
+      {
+         this->distanceTo[w] = distThruE;
+         this->edgeTo[w] = e;
+
+         if (!onQueue[w])
+         {
+            queue.push(w);
+            onQueue[w] = true;
+         }
+
+         if (++nbRelaxations % this->distanceTo.size() == 0)
+            cycle = this->edgeToCycle(source);
+      }
+   }
+
+public:
+
+   /**
+    * @brief Constructeur à partir du graphe g et du sommet v à la source
+    *        des plus courts chemins.
+    * @param g Graphe où calculer les plus courts chemins.
+    * @param v Numéro du sommet source.
+    */
+   BellmanFordQueueSP (const GraphType &g, int v) : onQueue(g.V(), false), nbRelaxations(0), source(v)
+   {
+      this->edgeTo.resize(g.V());
+      this->distanceTo.assign(g.V(), std::numeric_limits<Weight>::max());
+
+      this->edgeTo[v] = Edge(v, v, 0);
+      this->distanceTo[v] = 0;
+
+      queue.push(v);
+      onQueue[v] = true;
+
+      while (!queue.empty() && cycle.empty())
+      {
+         int u = queue.front();
+         queue.pop();
+         onQueue[u] = false;
+
+         g.forEachAdjacentEdge(u, [this] (const Edge &e)
+         {
+            this->relax(e);
+         });
+      }
+   }
+
+   /**
+    * @brief Indique si un circuit absorbant est accessible depuis la source.
+    * @details Dans ce cas, distanceTo et edgeTo ne sont pas des plus courts chemins.
+    */
+   bool hasNegativeCycle () const
+   {
+      return !cycle.empty();
+   }
+
+   /**
+    * @brief Renvoie les arcs du circuit absorbant dans l'ordre de parcours,
+    *        ou une liste vide s'il n'y en a pas.
+    */
+   const std::list<Edge> &NegativeCycle () const
+   {
+      return cycle;
+   }
+};
+
+/**
+ * @brief Vue d'un graphe orienté ajoutant le parcours des arcs entrants.
+ * @tparam GraphType Doit définir V(), forEachEdge(Func) et forEachAdjacentEdge(int, Func).
+ * @details Les arcs entrants sont regroupés une fois pour toutes, par sommet
+ *          d'arrivée, dans des tableaux contigus. Utile pour les graphes qui,
+ *          comme GraphWeightedDirected, ne donnent que leurs arcs sortants.
+ */
+template<typename GraphType>
+class IncomingEdgesView
+{
+public:
+   typedef EdgeWeightedDirected<double> Edge;
+
+private:
+   const GraphType &g;
+
+   // Les arcs entrant en v sont incoming[offsets[v]] à incoming[offsets[v+1]-1].
+   std::vector<int> offsets;
+   std::vector<Edge> incoming;
+
+public:
+
+   explicit IncomingEdgesView (const GraphType &g) : g(g), offsets(g.V() + 1, 0)
+   {
+      g.forEachEdge([this] (const Edge &e) { ++offsets[e.To() + 1]; });
+      for (int v = 0; v < g.V(); ++v)
+         offsets[v + 1] += offsets[v];
+
+      incoming.resize(offsets.back());
+      std::vector<int> next(offsets.begin(), offsets.end() - 1);
+      g.forEachEdge([&] (const Edge &e) { incoming[next[e.To()]++] = e; });
+   }
+
+   int V () const
+   {
+      return g.V();
+   }
+
+   template<typename Func>
+   void forEachVertex (Func f) const
+   {
+      g.forEachVertex(f);
+   }
+
+   template<typename Func>
+   void forEachEdge (Func f) const
+   {
+      g.forEachEdge(f);
+   }
+
+   template<typename Func>
+   void forEachAdjacentEdge (int v, Func f) const
+   {
+      g.forEachAdjacentEdge(v, f);
+   }
+
+   template<typename Func>
+   void forEachIncomingEdge (int v, Func f) const
+   {
+      for (int i = offsets[v]; i < offsets[v + 1]; ++i)
+         f(incoming[i]);
+   }
+};
+
+/**
+ * @brief Plus court chemin d'un sommet source à un sommet destination par
+ *        l'algorithme de Dijkstra bidirectionnel.
+ * @tparam GraphType Type du graphe pondéré orienté à traiter, à poids positifs.
+ * @details GraphType doit définir V(), forEachAdjacentEdge(int, Func) pour les
+ *          arcs sortants et forEachIncomingEdge(int, Func) pour les arcs
+ *          entrants (voir IncomingEdgesView et TrainGraphWrapperDirected).
+ *
+ *          Une recherche avant part de la source sur les arcs sortants, une
+ *          recherche arrière part de la destination sur les arcs entrants. On
+ *          avance à chaque pas la recherche dont le prochain sommet est le plus
+ *          proche. mu est la longueur du meilleur chemin passant par un sommet
+ *          atteint des deux côtés; le calcul s'arrête dès que la somme des deux
+ *          plus petites clés ne peut plus l'améliorer.
+ *
+ *          Les tableaux des deux recherches sont des SearchWorkspace. En les
+ *          fournissant, l'appelant enchaîne les requêtes sans allocation.
+ */
+template<typename GraphType>
+class BidirectionalDijkstraSP
+{
+public:
+   typedef double Weight;
+   typedef EdgeWeightedDirected<Weight> Edge;
+   typedef std::vector<Edge> Edges;
+
+private:
+   int source, target;
+
+   // Espaces de travail propres, utilisés si l'appelant n'en fournit pas.
+   SearchWorkspace ownForward, ownBackward;
+
+   // Recherches avant (depuis la source) et arrière (depuis la destination).
+   // forward->edgeTo(v): dernier arc du chemin source -> v.
+   // backward->edgeTo(v): premier arc du chemin v -> destination.
+   SearchWorkspace *forward, *backward;
+
+   // Longueur du meilleur chemin trouvé et sommet où les recherches se rejoignent.
+   Weight mu;
+   int meet;
+
+   // Mise à jour de mu si v est atteint par les deux recherches
+   void meetAt (int v)
+   {
+      if (forward->reached(v) && backward->reached(v) && forward->distance(v) + backward->distance(v) < mu)
+      {
+         mu = forward->distance(v) + backward->distance(v);
+         meet = v;
+      }
+   }
+
+   void run (const GraphType &g)
+   {
+      forward->reset(g.V());
+      backward->reset(g.V());
+      IndexMinPQ<Weight> &pqF = forward->queue(), &pqB = backward->queue();
+
+      forward->update(source, 0, Edge(source, source, 0));
+      backward->update(target, 0, Edge(target, target, 0));
+      pqF.push(source, 0);
+      pqB.push(target, 0);
+      meetAt(source);
+
+      while (!pqF.empty() && !pqB.empty())
+      {
+         Weight topF = forward->distance(pqF.minVertex());
+         Weight topB = backward->distance(pqB.minVertex());
+         if (topF + topB >= mu)
+            break;
+
+         if (topF <= topB)
+         {
+            int u = pqF.popMin();
+            g.forEachAdjacentEdge(u, [&] (const Edge &e)
+            {
+               int w = e.To();
+               Weight d = topF + e.Weight();
+               if (d < forward->distance(w))
+               {
+                  forward->update(w, d, e);
+                  if (pqF.contains(w)) pqF.decreaseKey(w, d);
+                  else                 pqF.push(w, d);
+                  meetAt(w);
+               }
+            });
+         }
+         else
+         {
+            int u = pqB.popMin();
+            g.forEachIncomingEdge(u, [&] (const Edge &e)
+            {
+               int w = e.From();
+               Weight d = topB + e.Weight();
+               if (d < backward->distance(w))
+               {
+                  backward->update(w, d, e);
+                  if (pqB.contains(w)) pqB.decreaseKey(w, d);
+                  else                 pqB.push(w, d);
+                  meetAt(w);
+               }
+            });
+         }
+      }
+   }
+
+public:
+
+   /**
+    * @brief Calcule le plus court chemin de s à t dans g.
+    * @param g Graphe à traiter.
+    * @param s Sommet source.
+    * @param t Sommet destination.
+    */
+   BidirectionalDijkstraSP (const GraphType &g, int s, int t)
+           : source(s), target(t), forward(&ownForward), backward(&ownBackward),
+             mu(std::numeric_limits<Weight>::max()), meet(-1)
+   {
+      run(g);
+   }
+
+   /**
+    * @brief Calcule le plus court chemin de s à t dans g dans les espaces de
+    *        travail, distincts, forwardWs et backwardWs.
+    * @details Rien n'est alloué si ces espaces ont déjà servi sur un graphe de
+    *          même taille. Le résultat n'est valide que tant qu'ils ne servent
+    *          pas à une autre recherche.
+    */
+   BidirectionalDijkstraSP (const GraphType &g, int s, int t, SearchWorkspace &forwardWs, SearchWorkspace &backwardWs)
+           : source(s), target(t), forward(&forwardWs), backward(&backwardWs),
+             mu(std::numeric_limits<Weight>::max()), meet(-1)
+   {
+      run(g);
+   }
+
+   // forward et backward peuvent pointer sur les membres de l'objet
+   BidirectionalDijkstraSP (const BidirectionalDijkstraSP &) = delete;
+   BidirectionalDijkstraSP &operator= (const BidirectionalDijkstraSP &) = delete;
+
+   // Indique si la destination est accessible depuis la source
+   bool hasPath () const
+   {
+      return meet != -1;
+   }
+
+   // Renvoie la longueur du plus court chemin, ou numeric_limits<double>::max()
+   // si la destination est inaccessible
+   Weight distance () const
+   {
+      return mu;
+   }
+
+   /**
+    * @brief Renvoie la liste ordonnée des arcs du plus court chemin de la
+    *        source à la destination, comme ShortestPath::PathTo.
+    */
+   Edges Path () const
+   {
+      Edges result;
+      Path(result);
+      return result;
+   }
+
+   /**
+    * @brief Remplace le contenu de result par les arcs du plus court chemin,
+    *        ce qui évite une allocation si result a déjà servi.
+    */
+   void Path (Edges &result) const
+   {
+      result.clear();
+      if (meet == -1) return;
+
+      for (int v = meet; v != source; v = forward->edgeTo(v).From())
+         result.push_back(forward->edgeTo(v));
+      std::reverse(result.begin(), result.end());
+
+      for (int v = meet; v != target; v = backward->edgeTo(v).To())
+         result.push_back(backward->edgeTo(v));
+   }
+};
+
+/**
+ * @brief Plus court chemin d'un sommet source à un sommet destination par
+ *        l'algorithme A*.
+ * @tparam GraphType Type du graphe pondéré orienté à traiter, à poids positifs.
+ * @details GraphType doit définir V() et forEachAdjacentEdge(int, Func).
+ *
+ *          C'est l'algorithme de Dijkstra où la clé d'un sommet v est sa
+ *          distance depuis la source augmentée d'un minorant h(v, t) de sa
+ *          distance jusqu'à la destination t: les sommets qui s'éloignent de
+ *          la destination sont traités plus tard, voire jamais. Le calcul
+ *          s'arrête dès que la destination est retirée de la file.
+ *
+ *          Le minorant doit être cohérent, c-a-d h(u, t) <= poids(u->w) +
+ *          h(w, t) pour tout arc u->w, et h(t, t) doit être nul (voir
+ *          GreatCircleBound). Un minorant nul redonne Dijkstra. Comme pour
+ *          BidirectionalDijkstraSP, un SearchWorkspace peut être fourni.
+ */
+template<typename GraphType>
+class AStarSP
+{
+public:
+   typedef double Weight;
+   typedef EdgeWeightedDirected<Weight> Edge;
+   typedef std::vector<Edge> Edges;
+
+private:
+   int source, target;
+
+   // Espace de travail propre, utilisé si l'appelant n'en fournit pas.
+   SearchWorkspace own;
+   SearchWorkspace *ws;
+
+   // Nombre de sommets retirés de la file
+   int nbSettled;
+
+   template<typename Heuristic>
+   void run (const GraphType &g, const Heuristic &h)
+   {
+      ws->reset(g.V());
+      IndexMinPQ<Weight> &pq = ws->queue();
+
+      ws->update(source, 0, Edge(source, source, 0));
+      pq.push(source, h(source, target));
+
+      while (!pq.empty())
+      {
+         int u = pq.popMin();
+         ++nbSettled;
+         if (u == target) break;
+
+         Weight du = ws->distance(u);
+         g.forEachAdjacentEdge(u, [&] (const Edge &e)
+         {
+            int w = e.To();
+            Weight d = du + e.Weight();
+            if (d < ws->distance(w))
+            {
+               // Un sommet déjà traité n'est remis dans la file que si le
+               // minorant n'est pas tout à fait cohérent (arrondis).
+               ws->update(w, d, e);
+               if (pq.contains(w)) pq.decreaseKey(w, d + h(w, target));
+               else                pq.push(w, d + h(w, target));
+            }
+         });
+      }
+   }
+
+public:
+
+   /**
+    * @brief Calcule le plus court chemin de s à t dans g.
+    * @param g Graphe à traiter.
+    * @param s Sommet source.
+    * @param t Sommet destination.
+    * @param h Fonction (int v, int t) renvoyant un minorant de la distance de
+    *          v à t. Elle n'est pas copiée et doit survivre au constructeur.
+    */
+   template<typename Heuristic>
+   AStarSP (const GraphType &g, int s, int t, const Heuristic &h)
+           : source(s), target(t), ws(&own), nbSettled(0)
+   {
+      run(g, h);
+   }
+
+   /**
+    * @brief Calcule le plus court chemin de s à t dans g dans l'espace de
+    *        travail workspace.
+    * @details Le résultat n'est valide que tant que workspace ne sert pas à
+    *          une autre recherche.
+    */
+   template<typename Heuristic>
+   AStarSP (const GraphType &g, int s, int t, const Heuristic &h, SearchWorkspace &workspace)
+           : source(s), target(t), ws(&workspace), nbSettled(0)
+   {
+      run(g, h);
+   }
+
+   // ws peut pointer sur un membre de l'objet
+   AStarSP (const AStarSP &) = delete;
+   AStarSP &operator= (const AStarSP &) = delete;
+
+   // Indique si la destination est accessible depuis la source
+   bool hasPath () const
+   {
+      return ws->reached(target);
+   }
+
+   // Renvoie la longueur du plus court chemin, ou numeric_limits<double>::max()
+   // si la destination est inaccessible
+   Weight distance () const
+   {
+      return ws->distance(target);
+   }
+
+   // Renvoie le nombre de sommets traités par la recherche
+   int nbExplored () const
+   {
+      return nbSettled;
+   }
+
+   /**
+    * @brief Renvoie la liste ordonnée des arcs du plus court chemin de la
+    *        source à la destination, comme ShortestPath::PathTo.
+    */
+   Edges Path () const
+   {
+      Edges result;
+      Path(result);
+      return result;
+   }
+
+   /**
+    * @brief Remplace le contenu de result par les arcs du plus court chemin,
+    *        ce qui évite une allocation si result a déjà servi.
+    */
+   void Path (Edges &result) const
+   {
+      result.clear();
+      if (!hasPath()) return;
+
+      for (int v = target; v != source; v = ws->edgeTo(v).From())
+         result.push_back(ws->edgeTo(v));
+      std::reverse(result.begin(), result.end());
+   }
+};
+
+/**
+ * @brief Plus court chemin passant successivement par une liste de villes.
+ * @tparam GraphType Type du graphe pondéré orienté à traiter, voir
+ *         BidirectionalDijkstraSP.
+ * @details Chaque étape waypoints[i] -> waypoints[i + 1] est une recherche
+ *          BidirectionalDijkstraSP indépendante sur le même graphe, qui n'est
+ *          que lu. Les étapes sont réparties entre les threads.
+ */
+template<typename GraphType>
+class ViaPointSP
+{
+public:
+   typedef double Weight;
+   typedef EdgeWeightedDirected<Weight> Edge;
+   typedef std::vector<Edge> Edges;
+
+private:
+   std::vector<Weight> legDistances;
+   std::vector<Edges> legPaths;
+   bool reachable;
+
+public:
+
+   /**
+    * @brief Calcule le plus court chemin passant par waypoints, dans l'ordre.
+    * @param g Graphe à traiter.
+    * @param waypoints Sommets à visiter, départ et arrivée compris.
+    * @param nbThreads Nombre de threads, 0 pour utiliser tous les coeurs.
+    */
+   ViaPointSP (const GraphType &g, const std::vector<int> &waypoints, unsigned nbThreads = 0)
+           : reachable(true)
+   {
+      int nbLegs = std::max(0, int(waypoints.size()) - 1);
+      legDistances.resize(nbLegs);
+      legPaths.resize(nbLegs);
+
+      if (nbLegs == 0) return;
+      nbThreads = std::min(threadCount(nbThreads), unsigned(nbLegs));
+
+      std::vector<char> found(nbLegs);
+      parallelFor(nbThreads, nbLegs, [&] (unsigned, int begin, int end)
+      {
+         // Chaque thread réutilise ses espaces de travail d'une étape à l'autre
+         SearchWorkspace forward, backward;
+         for (int i = begin; i < end; ++i)
+         {
+            BidirectionalDijkstraSP<GraphType> sp(g, waypoints[i], waypoints[i + 1], forward, backward);
+            found[i] = sp.hasPath();
+            legDistances[i] = sp.distance();
+            sp.Path(legPaths[i]);
+         }
+      });
+
+      for (char f : found)
+         reachable = reachable && f;
+   }
+
+   // Indique si toutes les étapes sont possibles
+   bool hasPath () const
+   {
+      return reachable;
+   }
+
+   // Longueur totale, ou numeric_limits<double>::max() si une étape est impossible
+   Weight distance () const
+   {
+      if (!reachable) return std::numeric_limits<Weight>::max();
+
+      Weight total = 0;
+      for (Weight d : legDistances) total += d;
+      return total;
+   }
+
+   // Nombre d'étapes
+   size_t nbLegs () const
+   {
+      return legPaths.size();
+   }
+
+   // Longueur de l'étape i
+   Weight legDistance (size_t i) const
+   {
+      return legDistances.at(i);
+   }
+
+   // Arcs de l'étape i, vide si elle est impossible
+   const Edges &Leg (size_t i) const
+   {
+      return legPaths.at(i);
+   }
+
+   /**
+    * @brief Renvoie la liste ordonnée des arcs de tout le trajet, vide si une
+    *        étape est impossible.
+    */
+   Edges Path () const
+   {
+      Edges result;
+      if (!reachable) return result;
+
+      for (const Edges &leg : legPaths)
+         result.insert(result.end(), leg.begin(), leg.end());
+      return result;
+   }
+};
+
+/**
+ * @brief Table des distances entre un ensemble de sources et un ensemble de
+ *        destinations.
+ * @tparam GraphType Type du graphe pondéré orienté à traiter, qui doit définir
+ *         V() et forEachAdjacentEdge(int, Func), comme
+ *         TrainGraphWrapperDirected ou GraphWeightedDirected.
+ * @details Un Dijkstra par source, arrêté dès que toutes les destinations
+ *          sont fixées. Les sources sont réparties dynamiquement entre les
+ *          threads, chacun réutilisant son SearchWorkspace d'une source à
+ *          l'autre. Pour de nombreuses requêtes sur un même réseau, voir
+ *          aussi ContractionHierarchy::table.
+ */
+template<typename GraphType>
+class DistanceTable
+{
+public:
+   typedef double Weight;
+   typedef EdgeWeightedDirected<Weight> Edge;
+
+private:
+   size_t nbCols;
+
+   // Distances, ligne par ligne: matrix[i * nbCols + j] va de sources[i] à targets[j]
+   std::vector<Weight> matrix;
+
+public:
+
+   /**
+    * @brief Calcule les distances de chaque source à chaque destination.
+    * @param g Graphe à traiter, poids non négatifs.
+    * @param sources Sommets de départ, un par ligne.
+    * @param targets Sommets d'arrivée, un par colonne.
+    * @param nbThreads Nombre de threads, 0 pour utiliser tous les coeurs.
+    */
+   DistanceTable (const GraphType &g, const std::vector<int> &sources, const std::vector<int> &targets,
+                  unsigned nbThreads = 0)
+           : nbCols(targets.size()),
+             matrix(sources.size() * targets.size(), std::numeric_limits<Weight>::max())
+   {
+      if (sources.empty() || targets.empty()) return;
+
+      // Nombre de destinations distinctes
+      std::vector<bool> isTarget(g.V(), false);
+      int nbTargets = 0;
+      for (int t : targets)
+      {
+         if (!isTarget[t]) ++nbTargets;
+         isTarget[t] = true;
+      }
+
+      std::atomic<size_t> nextSource(0);
+      nbThreads = std::min(threadCount(nbThreads), unsigned(sources.size()));
+
+      parallelFor(nbThreads, int(nbThreads), [&] (unsigned, int, int)
+      {
+         SearchWorkspace ws(g.V());
+         IndexMinPQ<Weight> &pq = ws.queue();
+
+         for (size_t i = nextSource++; i < sources.size(); i = nextSource++)
+         {
+            ws.reset(g.V());
+            ws.update(sources[i], 0, Edge(sources[i], sources[i], 0));
+            pq.push(sources[i], 0);
+
+            int remaining = nbTargets;
+            while (!pq.empty() && remaining > 0)
+            {
+               int u = pq.popMin();
+               if (isTarget[u]) --remaining;
+
+               Weight du = ws.distance(u);
+               g.forEachAdjacentEdge(u, [&] (const Edge &e)
+               {
+                  int w = e.To();
+                  Weight d = du + e.Weight();
+                  if (d < ws.distance(w))
+                  {
+                     ws.update(w, d, e);
+                     if (pq.contains(w)) pq.decreaseKey(w, d);
+                     else                pq.push(w, d);
+                  }
+               });
+            }
+
+            for (size_t j = 0; j < nbCols; ++j)
+               matrix[i * nbCols + j] = ws.distance(targets[j]);
+         }
+      });
+   }
+
+   // Distance de sources[i] à targets[j], numeric_limits<double>::max() si inaccessible
+   Weight distance (size_t i, size_t j) const
+   {
+      return matrix.at(i * nbCols + j);
+   }
+
+   // Matrice complète, ligne par ligne
+   const std::vector<Weight> &Matrix () const
+   {
+      return matrix;
+   }
+};
+
 #endif
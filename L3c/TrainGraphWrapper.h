@@ -10,7 +10,10 @@
 #ifndef ASD2_TrainGraphWrapper_h
 #define ASD2_TrainGraphWrapper_h
 
+#include <algorithm>
 #include <functional>
+#include <limits>
+#include <vector>
 #include "TrainNetwork.h"
 #include "EdgeWeighted.h"
 #include "EdgeWeightedDirected.h"
@@ -21,19 +24,57 @@ class TrainGraphWrapperCommon
 protected:
    const TrainNetwork &tn;
 
-   // Fonction de cout
-   // Correspond typiquement à une expression lambda qui prend une ligne du
-   // TrainNetwork en paramètre et retourne un double qui correspond au cout de
-   // cette ligne.
-   const std::function<double (const TrainNetwork::Line &)> &costFunction;
+   // Cout de chaque ligne, indicé comme tn.lines. La fonction de cout
+   // (typiquement une expression lambda qui prend une ligne du TrainNetwork
+   // et retourne son cout) n'est appelée qu'une fois par ligne, à la
+   // construction.
+   std::vector<double> costs;
+
+   // Lignes de chaque ville au format CSR: les lignes de la ville v sont
+   // adjLines[offsets[v]] à adjLines[offsets[v + 1] - 1], dans l'ordre de
+   // tn.cities[v].lines, et adjOthers donne la ville à l'autre bout.
+   std::vector<int> offsets;
+   std::vector<size_t> adjLines;
+   std::vector<int> adjOthers;
 
    TrainGraphWrapperCommon (const TrainNetwork &tn,
                             const std::function<double (const TrainNetwork::Line &)> &costFunction)
-           : tn(tn), costFunction(costFunction)
-   {}
+           : tn(tn), offsets(tn.cities.size() + 1, 0)
+   {
+      costs.reserve(tn.lines.size());
+      for (const TrainNetwork::Line &line : tn.lines)
+         costs.push_back(costFunction(line));
+
+      for (size_t v = 0; v < tn.cities.size(); ++v)
+      {
+         offsets[v + 1] = offsets[v] + int(tn.cities[v].lines.size());
+         for (size_t i : tn.cities[v].lines)
+         {
+            const TrainNetwork::Line &line = tn.lines[i];
+            adjLines.push_back(i);
+            adjOthers.push_back(line.cities.first == int(v) ? line.cities.second : line.cities.first);
+         }
+      }
+   }
 
 public:
 
+   /**
+    * @brief Retourne le cout de la ligne d'indice i dans tn.lines.
+    */
+   double cost (size_t i) const
+   {
+      return costs[i];
+   }
+
+   /**
+    * @brief Retourne le nombre de lignes du réseau, c-à-d de couts.
+    */
+   size_t nbLines () const
+   {
+      return costs.size();
+   }
+
    /**
     * @brief Retourne le nombre de sommets dans le graphe, c-à-d le nb de villes du réseau ferroviaire.
     * @return Retourne le nombre de sommets dans le graphe simulé du réseau ferroviaire.
@@ -76,9 +117,9 @@ public:
    template<typename Func>
    void forEachEdge (Func f) const
    {
-      for(const TrainNetwork::Line& line : tn.lines)
+      for(size_t i = 0; i < tn.lines.size(); ++i)
       {
-         f(Edge(line.cities.first, line.cities.second, costFunction(line)));
+         f(Edge(tn.lines[i].cities.first, tn.lines[i].cities.second, costs[i]));
       }
    };
 
@@ -90,9 +131,10 @@ public:
    template<typename Func>
    void forEachAdjacentEdge (int v, Func f) const
    {
-      for(size_t i : tn.cities[v].lines)
+      for(int k = offsets[v]; k < offsets[v + 1]; ++k)
       {
-         f(Edge(tn.lines[i].cities.first, tn.lines[i].cities.second, costFunction(tn.lines[i])));
+         const TrainNetwork::Line& line = tn.lines[adjLines[k]];
+         f(Edge(line.cities.first, line.cities.second, costs[adjLines[k]]));
       }
    }
 };
@@ -102,42 +144,176 @@ class TrainGraphWrapperDirected : public TrainGraphWrapperCommon
 
    typedef EdgeWeightedDirected<double> Edge;
 
+   // Fermetures: les arcs d'une ligne fermée ou touchant une ville fermée
+   // ne sont jamais parcourus, quelle que soit la fonction de cout.
+   std::vector<bool> closedCities;
+   std::vector<bool> closedLines;
+
+   // Vrai si l'arc de la case k du CSR, partant d'une ville ouverte, est ouvert
+   bool isOpen (int k) const
+   {
+      return !closedLines[adjLines[k]] && !closedCities[adjOthers[k]];
+   }
+
 public:
 
    TrainGraphWrapperDirected (const TrainNetwork &tn,
                               const std::function<double (const TrainNetwork::Line &)> &costFunction)
-           : TrainGraphWrapperCommon(tn, costFunction)
+           : TrainGraphWrapperCommon(tn, costFunction),
+             closedCities(tn.cities.size(), false), closedLines(tn.lines.size(), false)
    {}
 
+   /**
+    * @brief Ferme (ou rouvre) la gare de la ville v: aucun arc n'y entre ni
+    *        n'en sort.
+    */
+   void closeCity (int v, bool closed = true)
+   {
+      closedCities.at(v) = closed;
+   }
+
+   /**
+    * @brief Ferme (ou rouvre) la ligne d'indice i dans tn.lines, dans les
+    *        deux sens.
+    */
+   void closeLine (size_t i, bool closed = true)
+   {
+      closedLines.at(i) = closed;
+   }
+
+   /**
+    * @brief Rouvre toutes les villes et toutes les lignes.
+    */
+   void reopenAll ()
+   {
+      std::fill(closedCities.begin(), closedCities.end(), false);
+      std::fill(closedLines.begin(), closedLines.end(), false);
+   }
+
+   bool isCityClosed (int v) const
+   {
+      return closedCities.at(v);
+   }
+
+   bool isLineClosed (size_t i) const
+   {
+      return closedLines.at(i);
+   }
+
    /**
     * @brief Applique la fonction f à chaque EdgeWeightedDirected<double> Edge
-    *        dérivé du réseau ferroviaire.
+    *        dérivé du réseau ferroviaire, sauf les arcs fermés.
     * @param f Fonction à appliquer.
     */
    template<typename Func>
    void forEachEdge (Func f) const
    {
-      for(const TrainNetwork::Line& line : tn.lines)
+      for(size_t i = 0; i < tn.lines.size(); ++i)
       {
-         f(Edge(line.cities.first , line.cities.second, costFunction(line)));
-         f(Edge(line.cities.second, line.cities.first, costFunction(line)));
+         int first = tn.lines[i].cities.first, second = tn.lines[i].cities.second;
+         if (closedLines[i] || closedCities[first] || closedCities[second]) continue;
+
+         f(Edge(first , second, costs[i]));
+         f(Edge(second, first, costs[i]));
       }
    };
 
    /**
-    * @brief Applique la fonction f à tous les EdgeWeightedDirected<double> connecté à v.
-    * @param v Sommet à traîter les arrêtes connecté (entrantes et sortantes).
+    * @brief Applique la fonction f à tous les EdgeWeightedDirected<double>
+    *        ouverts sortant de v.
+    * @param v Sommet dont on parcourt les arcs sortants.
     * @param f Fonction à appliquer.
     */
    template<typename Func>
    void forEachAdjacentEdge (int v, Func f) const
    {
-      for(int i : tn.cities[v].lines)
+      if (closedCities[v]) return;
+      for(int k = offsets[v]; k < offsets[v + 1]; ++k)
+      {
+         if (isOpen(k)) f(Edge(v, adjOthers[k], costs[adjLines[k]]));
+      }
+   }
+
+   /**
+    * @brief Applique la fonction f à tous les EdgeWeightedDirected<double>
+    *        ouverts entrant en v.
+    * @param v Sommet dont on parcourt les arcs entrants.
+    * @param f Fonction à appliquer.
+    * @details Les lignes étant parcourables dans les deux sens, ce sont les
+    *          arcs sortants de v retournés.
+    */
+   template<typename Func>
+   void forEachIncomingEdge (int v, Func f) const
+   {
+      if (closedCities[v]) return;
+      for(int k = offsets[v]; k < offsets[v + 1]; ++k)
+      {
+         if (isOpen(k)) f(Edge(adjOthers[k], v, costs[adjLines[k]]));
+      }
+   }
+
+   /**
+    * @brief Applique la fonction f à tous les arcs ouverts sortant de v,
+    *        accompagnés de l'indice dans tn.lines de la ligne dont ils sont issus.
+    * @param v Sommet dont on parcourt les arcs sortants.
+    * @param f Fonction prenant un EdgeWeightedDirected<double> et un size_t.
+    */
+   template<typename Func>
+   void forEachAdjacentLine (int v, Func f) const
+   {
+      if (closedCities[v]) return;
+      for(int k = offsets[v]; k < offsets[v + 1]; ++k)
       {
-         f(Edge(tn.lines[i].cities.first, tn.lines[i].cities.second, costFunction(tn.lines[i])));
-         f(Edge(tn.lines[i].cities.second, tn.lines[i].cities.first, costFunction(tn.lines[i])));
+         if (isOpen(k)) f(Edge(v, adjOthers[k], costs[adjLines[k]]), adjLines[k]);
       }
    }
 };
 
+/**
+ * @brief Minorant à vol d'oiseau du cout restant entre deux villes, à passer
+ *        à AStarSP.
+ * @details Le cout d'une ligne est au moins costPerKm fois la distance à vol
+ *          d'oiseau entre ses deux villes, où costPerKm est le plus petit
+ *          rapport cout / distance à vol d'oiseau des lignes du réseau. Par
+ *          l'inégalité triangulaire, costPerKm fois la distance à vol d'oiseau
+ *          jusqu'à la destination est alors un minorant cohérent.
+ *
+ *          Avec les longueurs comme couts, costPerKm vaut à peu près 1. Avec
+ *          les durées, c'est l'inverse de la vitesse maximale du réseau: le
+ *          minorant est la distance à vol d'oiseau divisée par cette vitesse.
+ *          Calibrer sur les lignes plutôt que de supposer 1 protège en outre
+ *          des imprécisions du fichier de coordonnées.
+ *
+ *          Si une ville n'a pas de coordonnées, le minorant est nul et A*
+ *          se comporte comme Dijkstra.
+ */
+class GreatCircleBound
+{
+   const TrainNetwork &tn;
+   double costPerKm;
+
+public:
+
+   GreatCircleBound (const TrainNetwork &tn, const TrainGraphWrapperCommon &g) : tn(tn), costPerKm(0)
+   {
+      if (!tn.hasCoordinates()) return;
+
+      costPerKm = std::numeric_limits<double>::max();
+      for (size_t i = 0; i < tn.lines.size(); ++i)
+      {
+         double km = tn.greatCircleDistance(tn.lines[i].cities.first, tn.lines[i].cities.second);
+         if (km > 0) costPerKm = std::min(costPerKm, g.cost(i) / km);
+      }
+      if (costPerKm == std::numeric_limits<double>::max()) costPerKm = 0;
+   }
+
+   /**
+    * @brief Renvoie un minorant du cout d'un itinéraire de la ville v à la ville t.
+    */
+   double operator() (int v, int t) const
+   {
+      return costPerKm == 0 ? 0 : costPerKm * tn.greatCircleDistance(v, t);
+   }
+};
+
 #endif
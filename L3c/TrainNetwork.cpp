@@ -8,6 +8,10 @@
 
 #include "TrainNetwork.h"
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
 TrainNetwork::TrainNetwork(const std::string& filename) {
     std::ifstream s(filename);
 
@@ -27,23 +31,91 @@ TrainNetwork::TrainNetwork(const std::string& filename) {
         } else --i;
     }
 
-    while (s.good()) {
-        std::string line;
-        std::getline(s, line);
+    // Le tampon de ligne et la cle sont reutilises d'une ligne a l'autre,
+    // les champs sont lus sans copie.
+    std::string line, key;
+    StringToken fields[5];
+    while (std::getline(s, line)) {
+        if (!line.empty() && line[line.size() - 1] == '\r')
+            line.erase(line.size() - 1);
+        if (line.empty())
+            continue;
+
+        Tokenizer tokenizer(line, ';');
+        int nbFields = 0;
+        while (nbFields < 5 && tokenizer.next(fields[nbFields]))
+            ++nbFields;
 
-        auto elements = split(line, ';');
+        double length, duration;
+        int nbTracks;
+        if (nbFields < 5 || !parseDouble(fields[2], length) || !parseDouble(fields[3], duration)
+            || !parseInt(fields[4], nbTracks))
+            throw std::runtime_error("TrainNetwork : ligne invalide dans " + filename);
 
-        size_t s1 = cityIdx[elements[0]];
-        size_t s2 = cityIdx[elements[1]];
+        key.assign(fields[0].data, fields[0].size);
+        size_t s1 = cityIdx[key];
+        key.assign(fields[1].data, fields[1].size);
+        size_t s2 = cityIdx[key];
 
         size_t rIdx = lines.size();
         cities[s1].lines.push_back(rIdx);
         cities[s2].lines.push_back(rIdx);
-        lines.emplace_back(s1, s2,
-                           std::stod(elements[2]),
-                           std::stod(elements[3]),
-                           std::stoi(elements[4])
-        );
+        lines.emplace_back(s1, s2, length, duration, nbTracks);
     }
     s.close();
 }
+
+void TrainNetwork::loadCoordinates(const std::string& filename) {
+    std::ifstream s(filename);
+    if (!s)
+        throw std::runtime_error("TrainNetwork : impossible de lire " + filename);
+
+    std::string line, key;
+    StringToken fields[3];
+    while (std::getline(s, line)) {
+        if (!line.empty() && line[line.size() - 1] == '\r')
+            line.erase(line.size() - 1);
+        if (line.empty())
+            continue;
+
+        Tokenizer tokenizer(line, ';');
+        int nbFields = 0;
+        while (nbFields < 3 && tokenizer.next(fields[nbFields]))
+            ++nbFields;
+
+        double latitude, longitude;
+        if (nbFields < 3 || !parseDouble(fields[1], latitude) || !parseDouble(fields[2], longitude))
+            throw std::runtime_error("TrainNetwork : ligne invalide dans " + filename);
+
+        key.assign(fields[0].data, fields[0].size);
+        std::map<std::string, size_t>::const_iterator it = cityIdx.find(key);
+        if (it == cityIdx.end())
+            throw std::runtime_error("TrainNetwork : ville inconnue " + key + " dans " + filename);
+
+        City& city = cities[it->second];
+        city.located = true;
+        city.latitude = latitude;
+        city.longitude = longitude;
+    }
+}
+
+bool TrainNetwork::hasCoordinates() const {
+    for (const City& city : cities)
+        if (!city.located)
+            return false;
+    return true;
+}
+
+double TrainNetwork::greatCircleDistance(size_t c1, size_t c2) const {
+    // Formule de haversine sur une sphere de rayon terrestre moyen
+    const double earthRadius = 6371.0;
+    const double toRadians = std::acos(-1.0) / 180.0;
+
+    double lat1 = cities[c1].latitude * toRadians, lat2 = cities[c2].latitude * toRadians;
+    double dLat = lat2 - lat1;
+    double dLon = (cities[c2].longitude - cities[c1].longitude) * toRadians;
+
+    double a = std::sin(dLat / 2) * std::sin(dLat / 2)
+               + std::cos(lat1) * std::cos(lat2) * std::sin(dLon / 2) * std::sin(dLon / 2);
+    return 2 * earthRadius * std::asin(std::min(1.0, std::sqrt(a)));
+}
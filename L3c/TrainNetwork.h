@@ -26,11 +26,15 @@ class TrainNetwork {
 public:
 
     // Classe City stocke le nom de la ville et l'indice des lignes qui
-    // en partent dans le tableau lines
+    // en partent dans le tableau lines, ainsi que ses coordonnees
+    // geographiques en degres si elles ont ete chargees (located).
     struct City {
     public:
         std::string name;
         std::vector<size_t> lines;
+        bool located = false;
+        double latitude = 0;
+        double longitude = 0;
     };
 
     // Classe Line, stocke les indices dans cities des deux villes que la ligne relie,
@@ -70,6 +74,18 @@ public:
 
     // Constructeur avec nom de fichier.
     TrainNetwork(const std::string& filename);
+
+    // Lit les coordonnees des villes dans un fichier annexe dont chaque ligne
+    // est de la forme "ville;latitude;longitude", en degres. Les villes
+    // absentes du fichier restent sans coordonnees.
+    void loadCoordinates(const std::string& filename);
+
+    // Vrai si toutes les villes ont des coordonnees
+    bool hasCoordinates() const;
+
+    // Distance a vol d'oiseau en kilometres entre les villes d'indices c1 et
+    // c2, qui doivent avoir des coordonnees.
+    double greatCircleDistance(size_t c1, size_t c2) const;
 };
 
 
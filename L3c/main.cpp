@@ -8,39 +8,56 @@
  */
 
 #include <iostream>
+#include <cmath>
+#include <cstdio>
 #include "TrainNetwork.h"
 #include "TrainGraphWrapper.h"
 
 #include "MinimumSpanningTree.h"
 #include "ShortestPath.h"
+#include "ParetoSearch.h"
+#include "ContractionHierarchy.h"
 
 using namespace std;
 
 using costFunction = function<double (const TrainNetwork::Line &)>;
 
 /**
- * @brief Renvoie l'itineraire entre la ville de départ et d'arrivée en respectant fCost.
+ * @brief Tableaux de recherche et chemin de chemin(), que l'appelant réutilise
+ *        d'une requête à l'autre. Un même espace ne sert qu'à un appel à la fois.
+ */
+struct EspaceRecherche
+{
+   SearchWorkspace forward, backward;
+   vector<EdgeWeightedDirected<double>> path;
+};
+
+/**
+ * @brief Renvoie l'itineraire entre la ville de départ et d'arrivée dans tdgw.
  * @param vDepart No de sommet de la ville de départ.
  * @param vArriveeNo de sommet de la ville d'arrivée.
- * @param fCost Fonction de coût à appliquer sur les lignes de trainNetwork
+ * @param tdgw Graphe du réseau, avec sa fonction de coût et ses fermetures.
  * @param tn Trainnetwork Contenant les sommet et les arrêtes du graphe à traiter.
+ * @param espace Tableaux de recherche à utiliser.
  * @param outDist Variable où stocker le coût total entre départ et arrivée.
  * @param outItineraire Variable où stocker le string qui décrit l'itinéraire.
  */
-void chemin(int vDepart, int vArrivee, costFunction fCost,const TrainNetwork &tn, double* outDist, string* outItineraire)
+void chemin(int vDepart, int vArrivee, const TrainGraphWrapperDirected &tdgw, const TrainNetwork &tn,
+            EspaceRecherche &espace, double* outDist, string* outItineraire)
 {
-   // Création de l'arborescence BelmanFord sur la trainNetwork
-   TrainGraphWrapperDirected tdgw(tn, fCost);
-   BellmanFordSP<TrainGraphWrapperDirected> sp(tdgw, vDepart);
+   vector<EdgeWeightedDirected<double>> &path = espace.path;
+
+   // Recherche bidirectionnelle du plus court chemin sur la trainNetwork
+   BidirectionalDijkstraSP<TrainGraphWrapperDirected> sp(tdgw, vDepart, vArrivee, espace.forward, espace.backward);
 
    // Retour de la distance depuis la ville de départ jusqu'a l'arrivée.
-   *outDist = sp.distanceToVertex(vArrivee);
+   *outDist = sp.distance();
 
    // Construction de l'itinéraire.
-   string itineraire;
+   string itineraire = tn.cities[vDepart].name;
 
-   itineraire += tn.cities[sp.PathTo(vArrivee)[0].From()].name;
-   for(const auto& e : sp.PathTo(vArrivee))
+   sp.Path(path);
+   for(const auto& e : path)
    {
       itineraire += " -> " + tn.cities[e.To()].name;
    }
@@ -55,8 +72,9 @@ void chemin(int vDepart, int vArrivee, costFunction fCost,const TrainNetwork &tn
  * @param depart Nom de la ville de départ.
  * @param arrivee Nom de la ville d'arrivée
  * @param tn Réseau ferroviaire.
+ * @param espace Tableaux de recherche à utiliser.
  */
-void PlusCourtChemin (const string &depart, const string &arrivee, TrainNetwork &tn)
+void PlusCourtChemin (const string &depart, const string &arrivee, TrainNetwork &tn, EspaceRecherche &espace)
 {
    int noDepart  = tn.cityIdx.find(depart)->second;
    int noArrivee = tn.cityIdx.find(arrivee)->second;
@@ -69,7 +87,7 @@ void PlusCourtChemin (const string &depart, const string &arrivee, TrainNetwork
    double distance;
    string itineraire;
 
-   chemin(noDepart, noArrivee, getLength, tn, &distance, &itineraire);
+   chemin(noDepart, noArrivee, TrainGraphWrapperDirected(tn, getLength), tn, espace, &distance, &itineraire);
 
    cout << "Longueur = " << distance << " km" << endl;
    cout << "Via " << itineraire << endl;
@@ -84,24 +102,28 @@ void PlusCourtChemin (const string &depart, const string &arrivee, TrainNetwork
  * @param arrivee Nom de la ville d'arrivée
  * @param gareEnTravaux Nom de la ville où la gare est en travaux.
  * @param tn Réseau ferroviaire.
+ * @param espace Tableaux de recherche à utiliser.
  */
-void PlusCourtCheminAvecTravaux (const string &depart, const string &arrivee, const string &gareEnTravaux, TrainNetwork &tn)
+void PlusCourtCheminAvecTravaux (const string &depart, const string &arrivee, const string &gareEnTravaux, TrainNetwork &tn,
+                                 EspaceRecherche &espace)
 {
    int noDepart  = tn.cityIdx.find(depart)->second;
    int noArrivee = tn.cityIdx.find(arrivee)->second;
    int noTravaux = tn.cityIdx.find(gareEnTravaux)->second;
 
-   costFunction getLength = [&] (const TrainNetwork::Line &line)
+   costFunction getLength = [] (const TrainNetwork::Line &line)
    {
-      //Si la gare de départ est la gare en travaux
-      if( noTravaux == line.cities.first) return numeric_limits<double>::max();
       return line.length;
    };
-   
+
+   // La gare en travaux est retirée du graphe, ses lignes ne sont pas parcourues
+   TrainGraphWrapperDirected tdgw(tn, getLength);
+   tdgw.closeCity(noTravaux);
+
    double distance;
    string itineraire;
 
-   chemin(noDepart, noArrivee, getLength, tn, &distance, &itineraire);
+   chemin(noDepart, noArrivee, tdgw, tn, espace, &distance, &itineraire);
 
    cout << "Longueur = " << distance << " km" << endl;
    cout << "Via " << itineraire << endl;
@@ -127,14 +149,51 @@ void PlusRapideChemin (const string &depart, const string &arrivee, const string
    int noArrivee = tn.cityIdx.find(arrivee)->second;
    int noVia     = tn.cityIdx.find(via)->second;
 
-   double distance1, distance2;
-   string itineraire1, itineraire2;
+   // Les deux étapes partagent le même graphe et sont calculées en parallèle
+   TrainGraphWrapperDirected tdgw(tn, getTime);
+   ViaPointSP<TrainGraphWrapperDirected> sp(tdgw, {noDepart, noVia, noArrivee});
+
+   string itineraire = tn.cities[noDepart].name;
+   for(const auto& e : sp.Path())
+   {
+      itineraire += " -> " + tn.cities[e.To()].name;
+   }
+
+   cout << "Temps = " << sp.distance() << " minutes" << endl;
+   cout << "Via " << itineraire << endl;
+}
+
+/**
+ * @brief Calcule et affiche le plus rapide chemin de la ville départ a la ville
+ *        arrivée par une recherche A* guidée par la distance à vol d'oiseau,
+ *        ainsi que le nombre de villes explorées avec et sans ce guidage.
+ * @param depart Nom de la ville de départ.
+ * @param arrivee Nom de la ville d'arrivée.
+ * @param tn Réseau ferroviaire, dont les villes ont des coordonnées.
+ */
+void PlusRapideCheminGuide (const string &depart, const string &arrivee, TrainNetwork &tn)
+{
+   costFunction getTime = [] (const TrainNetwork::Line &line)
+   {
+      return line.duration;
+   };
+
+   int noDepart  = tn.cityIdx.find(depart)->second;
+   int noArrivee = tn.cityIdx.find(arrivee)->second;
 
-   chemin(noDepart, noVia, getTime, tn, &distance1, &itineraire1);
-   chemin(noVia, noArrivee, getTime, tn, &distance2, &itineraire2);
+   TrainGraphWrapperDirected tdgw(tn, getTime);
+   AStarSP<TrainGraphWrapperDirected> sp(tdgw, noDepart, noArrivee, GreatCircleBound(tn, tdgw));
+   AStarSP<TrainGraphWrapperDirected> dijkstra(tdgw, noDepart, noArrivee, [] (int, int) { return 0.0; });
 
-   cout << "Temps = " << distance1 + distance2 << " minutes" << endl;
-   cout << "Via " << itineraire1 << itineraire2.substr(via.size()) << endl;
+   string itineraire = tn.cities[noDepart].name;
+   for(const auto& e : sp.Path())
+   {
+      itineraire += " -> " + tn.cities[e.To()].name;
+   }
+
+   cout << "Temps = " << sp.distance() << " minutes" << endl;
+   cout << "Via " << itineraire << endl;
+   cout << "Villes explorees : " << sp.nbExplored() << " (Dijkstra : " << dijkstra.nbExplored() << ")" << endl;
 }
 
 /**
@@ -176,25 +235,149 @@ void ReseauLeMoinsCher (TrainNetwork &tn)
    cout << "Coût Total: " << coutTotal << " MF" << endl;
 }
 
-//ARGS reseau.txt
+/**
+ * @brief Affiche les itinéraires de la ville départ a la ville arrivée
+ *        qu'aucun autre ne bat à la fois en longueur, en durée et en nombre
+ *        de voies de la ligne la plus étroite.
+ * @param depart Nom de la ville de départ.
+ * @param arrivee Nom de la ville d'arrivée
+ * @param tn Réseau ferroviaire.
+ */
+void MeilleursCompromis (const string &depart, const string &arrivee, TrainNetwork &tn)
+{
+   int noDepart  = tn.cityIdx.find(depart)->second;
+   int noArrivee = tn.cityIdx.find(arrivee)->second;
+
+   ParetoSearch recherche(tn, noDepart, noArrivee);
+
+   for(const auto& route : recherche.Front())
+   {
+      cout << route.length << " km, " << route.duration << " minutes, "
+           << route.nbTracks << " voie(s) au minimum" << endl;
+
+      string itineraire = tn.cities[route.cities.front()].name;
+      for(size_t i = 1; i < route.cities.size(); ++i)
+         itineraire += " -> " + tn.cities[route.cities[i]].name;
+      cout << "   Via " << itineraire << endl;
+   }
+}
+
+/**
+ * @brief Vérifie la hiérarchie de contraction de tn pour la fonction de coût
+ *        cost par comparaison avec BellmanFord, après l'avoir sauvée puis
+ *        rechargée.
+ * @param tn Réseau ferroviaire.
+ * @param cost Fonction de coût des lignes.
+ * @return True si, pour tout couple de villes, la requête donne la distance
+ *         de BellmanFord et si les lignes déroulées relient bien les villes
+ *         de l'itinéraire pour ce même coût.
+ */
+bool testContractionHierarchy (const TrainNetwork &tn, const costFunction &cost)
+{
+   TrainGraphWrapperDirected tdgw(tn, cost);
+
+   const string fichier = "hierarchie_test.txt";
+   ContractionHierarchy(tdgw).Save(fichier);
+   ContractionHierarchy ch(tdgw, fichier);
+   remove(fichier.c_str());
+
+   for(int s = 0; s < tdgw.V(); ++s)
+   {
+      BellmanFordSP<TrainGraphWrapperDirected> reference(tdgw, s);
+
+      for(int t = 0; t < tdgw.V(); ++t)
+      {
+         ContractionHierarchy::Route route = ch.query(s, t);
+         if(fabs(route.distance - reference.distanceToVertex(t)) > 0.000001 ||
+            route.cities.size() != route.lines.size() + 1 ||
+            route.cities.front() != s || route.cities.back() != t)
+         {
+            return false;
+         }
+
+         double total = 0;
+         for(size_t i = 0; i < route.lines.size(); ++i)
+         {
+            const TrainNetwork::Line &line = tn.lines[route.lines[i]];
+            pair<int, int> villes(route.cities[i], route.cities[i + 1]);
+            if(line.cities != villes && line.cities != make_pair(villes.second, villes.first))
+            {
+               return false;
+            }
+            total += cost(line);
+         }
+
+         if(fabs(total - route.distance) > 0.000001)
+         {
+            return false;
+         }
+      }
+   }
+
+   return true;
+}
+
+/**
+ * @brief Vérifie les tables de distances entre grandes gares, calculées par
+ *        DistanceTable et par ContractionHierarchy::table sur 4 threads, par
+ *        comparaison avec chemin.
+ * @param tn Réseau ferroviaire.
+ * @param espace Tableaux de recherche à utiliser pour chemin.
+ * @return True si chaque case des deux tables est la distance donnée par chemin.
+ */
+bool testTableDistances (const TrainNetwork &tn, EspaceRecherche &espace)
+{
+   vector<int> gares;
+   for(const char *nom : {"Geneve", "Lausanne", "Berne", "Bale", "Lucerne", "Zurich", "Coire", "Lugano"})
+   {
+      gares.push_back(tn.cityIdx.find(nom)->second);
+   }
+
+   TrainGraphWrapperDirected tdgw(tn, [] (const TrainNetwork::Line &line) { return line.length; });
+   DistanceTable<TrainGraphWrapperDirected> table(tdgw, gares, gares, 4);
+   vector<double> tableCH = ContractionHierarchy(tdgw).table(gares, gares, 4);
+
+   for(size_t i = 0; i < gares.size(); ++i)
+   {
+      for(size_t j = 0; j < gares.size(); ++j)
+      {
+         double distance;
+         string itineraire;
+         chemin(gares[i], gares[j], tdgw, tn, espace, &distance, &itineraire);
+
+         if(fabs(table.distance(i, j) - distance) > 0.000001 ||
+            fabs(tableCH[i * gares.size() + j] - distance) > 0.000001)
+         {
+            return false;
+         }
+      }
+   }
+
+   return true;
+}
+
+//ARGS reseau.txt [coordonnees.txt]
 int main (int argc, const char *argv[])
 {
 
-   if (argc != 2)
+   if (argc != 2 && argc != 3)
    {
-      cerr << "Le programme attend un seul fichier en argument" << endl;
+      cerr << "Le programme attend le fichier du reseau et, optionnellement, celui des coordonnees des villes" << endl;
       return EXIT_FAILURE;
    }
 
    TrainNetwork tn(argv[1]);
 
+   // Tableaux de recherche partagés par les requêtes successives
+   EspaceRecherche espace;
+
    cout << "1. Chemin le plus court entre Geneve et Coire" << endl;
 
-   PlusCourtChemin("Geneve", "Coire", tn);
+   PlusCourtChemin("Geneve", "Coire", tn, espace);
 
    cout << "\n2. Chemin le plus court entre Geneve et Coire, avec la gare de Sion en travaux" << endl;
 
-   PlusCourtCheminAvecTravaux("Geneve", "Coire", "Sion", tn);
+   PlusCourtCheminAvecTravaux("Geneve", "Coire", "Sion", tn, espace);
 
    cout << "\n3. Chemin le plus rapide entre Geneve et Coire en passant par Brigue" << endl;
 
@@ -208,5 +391,27 @@ int main (int argc, const char *argv[])
 
    ReseauLeMoinsCher(tn);
 
+   cout << "\n6. Meilleurs compromis longueur / duree / voies entre Geneve et Coire" << endl;
+
+   MeilleursCompromis("Geneve", "Coire", tn);
+
+   cout << "\n7. Verification des hierarchies de contraction" << endl;
+
+   costFunction longueur = [] (const TrainNetwork::Line &line) { return line.length; };
+   costFunction duree    = [] (const TrainNetwork::Line &line) { return line.duration; };
+
+   cout << "Longueur : " << (testContractionHierarchy(tn, longueur) ? "Le test a reussi" : "La verification a echouee") << endl;
+   cout << "Duree : "    << (testContractionHierarchy(tn, duree)    ? "Le test a reussi" : "La verification a echouee") << endl;
+   cout << "Tables entre grandes gares : " << (testTableDistances(tn, espace) ? "Le test a reussi" : "La verification a echouee") << endl;
+
+   if (argc == 3)
+   {
+      tn.loadCoordinates(argv[2]);
+
+      cout << "\n8. Chemin le plus rapide entre Geneve et Coire, recherche guidee par la distance a vol d'oiseau" << endl;
+
+      PlusRapideCheminGuide("Geneve", "Coire", tn);
+   }
+
    return EXIT_SUCCESS;
 }
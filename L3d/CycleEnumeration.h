@@ -0,0 +1,206 @@
+/*
+ * File:   CycleEnumeration.h
+ * Author: Berney Alec, Forestier Quentin, Herzig Melvyn
+ *
+ * Created on 17. octobre 2026
+ */
+
+#ifndef ASD2_CycleEnumeration_h
+#define ASD2_CycleEnumeration_h
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <vector>
+
+#include "Parallel.h"
+
+/**
+ * @brief Énumération de tous les circuits élémentaires de poids négatif
+ *        comportant au plus maxLength arcs.
+ * @tparam GraphType Type du graphe pondéré orienté à traiter.
+ * @details GraphType doit se comporter comme un GraphWeightedDirected et
+ *          définir V(), forEachVertex(Func) et forEachAdjacentEdge(int, Func),
+ *          ainsi que le type GraphType::Edge.
+ *
+ *          Chaque circuit est cherché depuis son plus petit sommet s, par un
+ *          parcours en profondeur limité aux sommets supérieurs à s. Avant le
+ *          parcours, on calcule pour chaque sommet v et chaque nombre d'arcs h
+ *          le poids minimal d'un chemin de v à s en au plus h arcs. Une branche
+ *          est abandonnée dès que son poids plus cette borne n'est plus négatif.
+ *
+ *          Les sommets de départ sont répartis dynamiquement entre les threads.
+ *          Avec des poids -log(taux), un circuit négatif est une opportunité
+ *          d'arbitrage dont le gain est exp(-poids).
+ */
+template<typename GraphType>
+class NegativeCycleEnumeration
+{
+public:
+   typedef typename GraphType::Edge Edge;
+   typedef typename Edge::WeightType Weight;
+
+   // Circuit trouvé: arcs dans l'ordre de parcours et poids total
+   struct Cycle
+   {
+      std::list<Edge> edges;
+      Weight weight;
+   };
+
+   /**
+    * @brief Appelle f(const Cycle&) pour chaque circuit négatif d'au plus
+    *        maxLength arcs.
+    * @param nbThreads Nombre de threads, 0 pour utiliser tous les coeurs.
+    * @details Les appels à f sont sérialisés, mais leur ordre dépend des
+    *          threads. Chaque circuit est rapporté une seule fois, à partir de
+    *          son plus petit sommet.
+    */
+   template<typename Func>
+   static void ForEach (const GraphType &g, int maxLength, Func f, unsigned nbThreads = 0)
+   {
+      if (maxLength < 1) return;
+
+      std::atomic<int> nextSeed(0);
+      std::mutex reportMutex;
+
+      nbThreads = std::min(threadCount(nbThreads), unsigned(std::max(1, g.V())));
+      parallelFor(nbThreads, int(nbThreads), [&] (unsigned, int, int)
+      {
+         Search search(g, maxLength);
+         for (int s = nextSeed++; s < g.V(); s = nextSeed++)
+         {
+            search.run(s, [&] (const Cycle &c)
+            {
+               std::lock_guard<std::mutex> lock(reportMutex);
+               f(c);
+            });
+         }
+      });
+   }
+
+   /**
+    * @brief Renvoie tous les circuits négatifs d'au plus maxLength arcs, du
+    *        plus négatif au moins négatif.
+    * @param nbThreads Nombre de threads, 0 pour utiliser tous les coeurs.
+    */
+   static std::vector<Cycle> Ranked (const GraphType &g, int maxLength, unsigned nbThreads = 0)
+   {
+      std::vector<Cycle> cycles;
+      ForEach(g, maxLength, [&cycles] (const Cycle &c) { cycles.push_back(c); }, nbThreads);
+
+      // à poids égal, ordre des arcs pour un résultat indépendant des threads
+      std::sort(cycles.begin(), cycles.end(), [] (const Cycle &a, const Cycle &b)
+      {
+         if (a.weight != b.weight) return a.weight < b.weight;
+         return std::lexicographical_compare(a.edges.begin(), a.edges.end(),
+                                             b.edges.begin(), b.edges.end(),
+                                             [] (const Edge &x, const Edge &y)
+                                             {
+                                                return x.From() != y.From() ? x.From() < y.From()
+                                                                            : x.To() < y.To();
+                                             });
+      });
+      return cycles;
+   }
+
+private:
+
+   // Recherche depuis un sommet de départ. Une instance par thread.
+   class Search
+   {
+      const GraphType &g;
+      int maxLength;
+      int seed;
+
+      // bound[h * V + v]: poids minimal d'un chemin de v à seed en au plus
+      // h arcs, sans passer par un sommet inférieur à seed.
+      std::vector<Weight> bound;
+
+      std::vector<Edge> path;
+      std::vector<bool> onPath;
+
+      static Weight infinity ()
+      {
+         return std::numeric_limits<Weight>::max();
+      }
+
+      void computeBounds ()
+      {
+         int V = g.V();
+         std::fill(bound.begin(), bound.begin() + V, infinity());
+         bound[seed] = 0;
+
+         for (int h = 1; h <= maxLength; ++h)
+         {
+            const Weight *previous = &bound[(h - 1) * V];
+            Weight *current = &bound[h * V];
+            for (int v = 0; v < V; ++v)
+            {
+               current[v] = previous[v];
+               if (v < seed) continue;
+               g.forEachAdjacentEdge(v, [&] (const Edge &e)
+               {
+                  int w = e.To();
+                  if (w >= seed && previous[w] != infinity())
+                     current[v] = std::min(current[v], e.Weight() + previous[w]);
+               });
+            }
+         }
+      }
+
+      template<typename Func>
+      void explore (int v, Weight weight, Func &report)
+      {
+         int remaining = maxLength - int(path.size());
+
+         g.forEachAdjacentEdge(v, [&] (const Edge &e)
+         {
+            int w = e.To();
+            if (w < seed) return;
+
+            Weight total = weight + e.Weight();
+            if (w == seed)
+            {
+               if (total < 0)
+               {
+                  Cycle c;
+                  c.edges.assign(path.begin(), path.end());
+                  c.edges.push_back(e);
+                  c.weight = total;
+                  report(c);
+               }
+            }
+            else if (remaining > 1 && !onPath[w]
+                     && bound[(remaining - 1) * g.V() + w] != infinity()
+                     && total + bound[(remaining - 1) * g.V() + w] < 0)
+            {
+               path.push_back(e);
+               onPath[w] = true;
+               explore(w, total, report);
+               onPath[w] = false;
+               path.pop_back();
+            }
+         });
+      }
+
+   public:
+      Search (const GraphType &g, int maxLength)
+              : g(g), maxLength(maxLength), seed(0),
+                bound(size_t(maxLength + 1) * g.V()), onPath(g.V(), false)
+      {
+         path.reserve(maxLength);
+      }
+
+      template<typename Func>
+      void run (int s, Func report)
+      {
+         seed = s;
+         computeBounds();
+         explore(s, 0, report);
+      }
+   };
+};
+
+#endif
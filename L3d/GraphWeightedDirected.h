@@ -51,6 +51,21 @@ public:
         this->edgeAdjacencyLists.at(v).push_back(Edge(v, w, weight));
     }
 
+// Remplace le poids de tous les arcs v->w par weight. Si aucun arc v->w
+// n'existe, il est ajoute. Renvoie vrai si l'arc existait deja.
+    bool setEdgeWeight(int v, int w, WeightType weight) {
+        bool found = false;
+        for (Edge& e : this->edgeAdjacencyLists.at(v)) {
+            if (e.To() == w) {
+                e = Edge(v, w, weight);
+                found = true;
+            }
+        }
+        if (!found)
+            addEdge(v, w, weight);
+        return found;
+    }
+
 // Parcours de tous les sommets adjacents au sommet v
 // la fonction f doit prendre un seul argument de type int
     template<typename Func>
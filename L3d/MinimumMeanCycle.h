@@ -0,0 +1,360 @@
+/*
+ * File:   MinimumMeanCycle.h
+ * Author: Berney Alec, Forestier Quentin, Herzig Melvyn
+ *
+ * Created on 17. octobre 2026
+ */
+
+#ifndef ASD2_MinimumMeanCycle_h
+#define ASD2_MinimumMeanCycle_h
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <list>
+#include <vector>
+
+/**
+ * @brief Circuit de poids moyen minimal (poids total / nombre d'arcs).
+ * @tparam GraphType Type du graphe pondéré orienté à traiter.
+ * @details GraphType doit se comporter comme un GraphWeightedDirected et
+ *          définir V() et forEachEdge(Func), ainsi que le type GraphType::Edge.
+ *
+ *          Le calcul utilise l'itération sur les politiques de Howard: chaque
+ *          sommet choisit un arc sortant, le graphe des choix ne contient que
+ *          des circuits et des arbres qui y mènent. On évalue la moyenne du
+ *          circuit atteint par chaque sommet, puis chaque sommet change d'arc
+ *          s'il mène à un meilleur circuit, jusqu'à stabilité. Si Howard ne
+ *          converge pas en MAX_ITERATIONS, on applique l'algorithme de Karp,
+ *          en O(VE).
+ *
+ *          Avec des poids -log(taux), le circuit trouvé maximise le gain moyen
+ *          par conversion, exp(-Mean()).
+ */
+template<typename GraphType>
+class MinimumMeanCycle
+{
+public:
+   typedef typename GraphType::Edge Edge;
+   typedef double Weight;
+
+private:
+   static const int MAX_ITERATIONS = 1000;
+
+   // Écart en dessous duquel deux valeurs sont considérées égales
+   static Weight epsilon ()
+   {
+      return 1e-12;
+   }
+
+   static Weight infinity ()
+   {
+      return std::numeric_limits<Weight>::max();
+   }
+
+   int V;
+
+   // Arcs du graphe, dans l'ordre de forEachEdge
+   std::vector<Edge> edges;
+
+   std::list<Edge> cycle;
+   Weight mean;
+
+   // Construit le circuit en suivant next[] depuis v jusqu'à une répétition
+   void extractCycle (int v, const std::vector<int> &next)
+   {
+      std::vector<bool> seen(V, false);
+      while (!seen[v])
+      {
+         seen[v] = true;
+         v = edges[next[v]].To();
+      }
+
+      cycle.clear();
+      mean = 0;
+      int u = v;
+      do
+      {
+         cycle.push_back(edges[next[u]]);
+         mean += edges[next[u]].Weight();
+         u = edges[next[u]].To();
+      } while (u != v);
+      mean /= Weight(cycle.size());
+   }
+
+   /**
+    * @brief Itération sur les politiques de Howard.
+    * @return Faux si elle n'a pas convergé.
+    */
+   bool howard ()
+   {
+      // On retire les sommets d'où aucun circuit n'est accessible
+      std::vector<int> outDegree(V, 0);
+      std::vector<std::vector<int>> inEdges(V);
+      for (int i = 0; i < int(edges.size()); ++i)
+      {
+         ++outDegree[edges[i].From()];
+         inEdges[edges[i].To()].push_back(i);
+      }
+
+      std::vector<bool> alive(V, true);
+      std::vector<int> sinks;
+      for (int v = 0; v < V; ++v)
+         if (outDegree[v] == 0) sinks.push_back(v);
+      while (!sinks.empty())
+      {
+         int v = sinks.back();
+         sinks.pop_back();
+         alive[v] = false;
+         for (int i : inEdges[v])
+            if (--outDegree[edges[i].From()] == 0) sinks.push_back(edges[i].From());
+      }
+
+      // Politique initiale: l'arc vivant le plus léger
+      std::vector<int> policy(V, -1);
+      for (int i = 0; i < int(edges.size()); ++i)
+      {
+         const Edge &e = edges[i];
+         if (alive[e.From()] && alive[e.To()]
+             && (policy[e.From()] == -1 || e.Weight() < edges[policy[e.From()]].Weight()))
+            policy[e.From()] = i;
+      }
+
+      bool any = false;
+      for (int v = 0; v < V; ++v) any = any || alive[v];
+      if (!any) return true;   // graphe sans circuit
+
+      std::vector<Weight> eta(V), d(V);
+      std::vector<int> state(V);
+      std::vector<std::vector<int>> children(V);
+
+      for (int iteration = 0; iteration < MAX_ITERATIONS; ++iteration)
+      {
+         // Évaluation: moyenne eta du circuit atteint et potentiel d relatif
+         for (int v = 0; v < V; ++v) children[v].clear();
+         for (int v = 0; v < V; ++v)
+            if (alive[v]) children[edges[policy[v]].To()].push_back(v);
+
+         std::fill(state.begin(), state.end(), 0);   // 0 nouveau, 1 en cours, 2 évalué
+         for (int s = 0; s < V; ++s)
+         {
+            if (!alive[s] || state[s] != 0) continue;
+
+            int v = s;
+            while (state[v] == 0)
+            {
+               state[v] = 1;
+               v = edges[policy[v]].To();
+            }
+            if (state[v] == 1)
+            {
+               // v est sur un nouveau circuit
+               Weight sum = 0;
+               int length = 0;
+               int u = v;
+               do
+               {
+                  sum += edges[policy[u]].Weight();
+                  ++length;
+                  u = edges[policy[u]].To();
+               } while (u != v);
+
+               eta[v] = sum / length;
+               d[v] = 0;
+               state[v] = 2;
+
+               // Parcours de l'arbre des sommets menant à v
+               std::vector<int> stack(1, v);
+               while (!stack.empty())
+               {
+                  int x = stack.back();
+                  stack.pop_back();
+                  for (int y : children[x])
+                  {
+                     if (state[y] == 2) continue;
+                     eta[y] = eta[x];
+                     d[y] = edges[policy[y]].Weight() - eta[x] + d[x];
+                     state[y] = 2;
+                     stack.push_back(y);
+                  }
+               }
+            }
+            // la remontée depuis s mène à ce circuit, elle vient d'être évaluée
+         }
+
+         // Amélioration: d'abord vers un meilleur circuit, sinon un meilleur potentiel
+         bool improved = false;
+         for (int i = 0; i < int(edges.size()); ++i)
+         {
+            const Edge &e = edges[i];
+            int u = e.From(), v = e.To();
+            if (alive[u] && alive[v] && eta[v] < eta[u] - epsilon())
+            {
+               eta[u] = eta[v];
+               policy[u] = i;
+               improved = true;
+            }
+         }
+
+         if (!improved)
+         {
+            for (int i = 0; i < int(edges.size()); ++i)
+            {
+               const Edge &e = edges[i];
+               int u = e.From(), v = e.To();
+               if (!alive[u] || !alive[v] || std::abs(eta[v] - eta[u]) > epsilon()) continue;
+
+               Weight value = d[v] + e.Weight() - eta[v];
+               if (value < d[u] - epsilon())
+               {
+                  d[u] = value;
+                  policy[u] = i;
+                  improved = true;
+               }
+            }
+         }
+
+         if (!improved)
+         {
+            int best = -1;
+            for (int v = 0; v < V; ++v)
+               if (alive[v] && (best == -1 || eta[v] < eta[best])) best = v;
+            extractCycle(best, policy);
+            return true;
+         }
+      }
+
+      return false;
+   }
+
+   // Algorithme de Karp, avec une source fictive reliée à tous les sommets
+   void karp ()
+   {
+      // dist[k * V + v]: poids minimal d'une marche de k arcs finissant en v
+      std::vector<Weight> dist(size_t(V + 1) * V, infinity());
+      std::vector<int> parent(size_t(V + 1) * V, -1);
+      std::fill(dist.begin(), dist.begin() + V, 0);
+
+      for (int k = 1; k <= V; ++k)
+      {
+         for (int i = 0; i < int(edges.size()); ++i)
+         {
+            const Edge &e = edges[i];
+            Weight previous = dist[(k - 1) * V + e.From()];
+            if (previous == infinity()) continue;
+            if (previous + e.Weight() < dist[k * V + e.To()])
+            {
+               dist[k * V + e.To()] = previous + e.Weight();
+               parent[k * V + e.To()] = i;
+            }
+         }
+      }
+
+      // min sur v de max sur k de (D_V(v) - D_k(v)) / (V - k)
+      int best = -1;
+      Weight bestValue = infinity();
+      for (int v = 0; v < V; ++v)
+      {
+         if (dist[V * V + v] == infinity()) continue;
+         Weight value = -infinity();
+         for (int k = 0; k < V; ++k)
+            if (dist[k * V + v] != infinity())
+               value = std::max(value, (dist[V * V + v] - dist[k * V + v]) / (V - k));
+         if (value < bestValue)
+         {
+            bestValue = value;
+            best = v;
+         }
+      }
+      if (best == -1) return;   // graphe sans circuit
+
+      // La marche de V arcs vers best contient un circuit de moyenne
+      // minimale, mais pas forcément le premier qui s'y répète: on évalue
+      // chacun de ses circuits élémentaires.
+      std::vector<int> walk(V + 1);
+      walk[V] = best;
+      for (int k = V; k > 0; --k)
+         walk[k - 1] = edges[parent[k * V + walk[k]]].From();
+
+      // prefix[k]: poids des k premiers arcs de la marche
+      std::vector<Weight> prefix(V + 1, 0);
+      for (int k = 1; k <= V; ++k)
+         prefix[k] = prefix[k - 1] + edges[parent[k * V + walk[k]]].Weight();
+
+      int first = -1, last = -1;
+      std::vector<int> seenFrom(V, -1);
+      for (int i = 0; i < V; ++i)
+      {
+         // walk[i..j] est élémentaire si aucun sommet ne s'y répète avant walk[i]
+         seenFrom[walk[i]] = i;
+         for (int j = i + 1; j <= V; ++j)
+         {
+            int v = walk[j];
+            if (v == walk[i])
+            {
+               Weight value = (prefix[j] - prefix[i]) / (j - i);
+               if (first == -1 || value < mean)
+               {
+                  first = i;
+                  last = j;
+                  mean = value;
+               }
+               break;
+            }
+            if (seenFrom[v] == i) break;
+            seenFrom[v] = i;
+         }
+      }
+
+      cycle.clear();
+      for (int j = first + 1; j <= last; ++j)
+         cycle.push_back(edges[parent[j * V + walk[j]]]);
+   }
+
+public:
+
+   /**
+    * @brief Constructeur à partir du graphe g.
+    */
+   explicit MinimumMeanCycle (const GraphType &g) : V(g.V()), mean(infinity())
+   {
+      g.forEachEdge([this] (const Edge &e)
+      {
+         edges.push_back(e);
+      });
+
+      if (!howard())
+      {
+         cycle.clear();
+         mean = infinity();
+         karp();
+      }
+   }
+
+   /**
+    * @brief Indique si le graphe contient un circuit.
+    */
+   bool hasCycle () const
+   {
+      return !cycle.empty();
+   }
+
+   /**
+    * @brief Poids moyen du circuit, infini si le graphe n'en a pas.
+    */
+   Weight Mean () const
+   {
+      return mean;
+   }
+
+   /**
+    * @brief Arcs du circuit de poids moyen minimal dans l'ordre de parcours,
+    *        ou une liste vide si le graphe n'a pas de circuit.
+    */
+   const std::list<Edge> &Cycle () const
+   {
+      return cycle;
+   }
+};
+
+#endif
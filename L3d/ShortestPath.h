@@ -10,10 +10,14 @@
 #define ASD2_ShortestPath_h
 
 #include <algorithm>
+#include <atomic>
 #include <vector>
-
+#include <queue>
+#include <list>
+#include <limits>
 #include <functional>
 #include "EdgeWeightedDirected.h"
+#include "Parallel.h"
 
 // Classe parente de toutes les classes de plus court chemin.
 // Defini les membres edgeTo et distanceTo commun à toutes ces
@@ -53,6 +57,51 @@ public:
 protected:
    Edges edgeTo;
    Weights distanceTo;
+
+   /**
+    * @brief Cherche un cycle dans le graphe des edgeTo.
+    * @param source Source des plus courts chemins.
+    * @return Arcs du cycle dans l'ordre de parcours, vide s'il n'y en a pas.
+    * @details Chaque sommet atteint est visité une seule fois: on remonte ses
+    *          edgeTo jusqu'à la source ou jusqu'à un sommet déjà traité. Si on
+    *          retombe sur un sommet de la remontée en cours, c'est un cycle.
+    *          Un tel cycle est toujours un circuit absorbant.
+    */
+   std::list<Edge> edgeToCycle (int source) const
+   {
+      std::list<Edge> cycle;
+      int V = int(distanceTo.size());
+      std::vector<int> visitedBy(V, -1);
+
+      // La source n'est une racine que tant qu'elle n'a pas été relâchée.
+      int root = distanceTo[source] == 0 ? source : -1;
+
+      for (int s = 0; s < V; ++s)
+      {
+         if (visitedBy[s] != -1 || distanceTo[s] == std::numeric_limits<Weight>::max())
+            continue;
+
+         int v = s;
+         while (v != root && visitedBy[v] == -1)
+         {
+            visitedBy[v] = s;
+            v = edgeTo[v].From();
+         }
+
+         if (v != root && visitedBy[v] == s)
+         {
+            // v est sur le cycle, on en fait le tour
+            int u = v;
+            do
+            {
+               cycle.push_front(edgeTo[u]);
+               u = edgeTo[u].From();
+            } while (u != v);
+            break;
+         }
+      }
+      return cycle;
+   }
 };
 
 // Algorithme de BellmanFord.
@@ -73,8 +122,8 @@ protected:
    typedef typename BASE::Edge Edge;
    typedef typename BASE::Weight Weight;
 
-   // Relachement de l'arc e
-   void relax (const Edge &e)
+   // Relachement de l'arc e. Renvoie vrai si distanceTo a diminue.
+   bool relax (const Edge &e)
    {
       int v = e.From(), w = e.To();
       Weight distThruE = this->distanceTo[v] + e.Weight();
@@ -83,102 +132,432 @@ protected:
       {
          this->distanceTo[w] = distThruE;
          this->edgeTo[w] = e;
+         return true;
       }
+      return false;
    }
 
 public:
 
    // Constructeur a partir du graphe g et du sommet v a la source
-   // des plus courts chemins
+   // des plus courts chemins. S'arrete des qu'une passe ne relache aucun arc.
    BellmanFordSP (const GraphType &g, int v)
    {
-
       this->edgeTo.resize(g.V());
       this->distanceTo.assign(g.V(), std::numeric_limits<Weight>::max());
 
       this->edgeTo[v] = Edge(v, v, 0);
       this->distanceTo[v] = 0;
 
-      for (int i = 0; i < g.V() - 1; ++i)
+      bool changed = true;
+      for (int i = 0; i < g.V() - 1 && changed; ++i)
       {
-         g.forEachEdge([this] (const Edge &e)
+         changed = false;
+         g.forEachEdge([this, &changed] (const Edge &e)
                        {
-                          this->relax(e);
+                          if (this->relax(e)) changed = true;
                        });
       }
    }
 };
 
 /**
- * @brief Vérifie si le graphe contient un circuit à coût négatif.
+ * @brief Algorithme de BellmanFord à base de file (SPFA).
  * @tparam GraphType Type du graphe pondéré orienté à traiter.
- * @details GraphType doit se comporter comme un
- *          GraphWeightedDirected et définir forEachEdge(Func),
- *          ainsi que le type GraphType::Edge. Ce dernier doit
- *          se comporter comme EdgeWeightedDirected, c-a-d définir From(),
- *          To() et Weight().
+ * @details GraphType doit se comporter comme un GraphWeightedDirected et
+ *          définir V() et forEachAdjacentEdge(int, Func), ainsi que le type
+ *          GraphType::Edge. Ce dernier doit se comporter comme
+ *          EdgeWeightedDirected, c-a-d définir From(), To() et Weight().
+ *
+ *          Seuls les arcs sortant des sommets dont la distance a changé sont
+ *          relâchés à nouveau. Tous les V relâchements réussis, on cherche un
+ *          cycle dans le graphe des edgeTo: s'il y en a un, c'est un circuit
+ *          absorbant et le calcul s'arrête.
  */
 template<typename GraphType>
-class BellmanFordCycleDetection : public BellmanFordSP<GraphType>
+class BellmanFordQueueSP : public ShortestPath<GraphType>
 {
-
-private:
-   typedef BellmanFordSP<GraphType> BASE;
+   typedef ShortestPath<GraphType> BASE;
    typedef typename BASE::Edge Edge;
    typedef typename BASE::Weight Weight;
 
-   std::vector<bool> isVerified;
+   // Sommets dont les arcs sortants doivent être relâchés.
+   std::queue<int> queue;
+   std::vector<bool> onQueue;
+
+   // Nombre de relâchements réussis depuis le début.
+   long long nbRelaxations;
+
+   // Circuit absorbant trouvé, vide s'il n'y en a pas.
+   std::list<Edge> cycle;
+
    int source;
 
    /**
-    * @brief vérifie si le sommet i peut remonter jusqu'a la source.
-    * @param i No du sommet à tester.
-    * @return Retour le numéro de la source sinon le numéro du premier sommet
-    *         rencontré appartenant à la boucle.
+    * @brief Relâche l'arc e et place son extrémité dans la file si sa distance
+    *        diminue.
+    */
+   void relax (const Edge &e)
+   {
+      int v = e.From(), w = e.To();
+      Weight distThruE = this->distanceTo[v] + e.Weight();
+
+      if (this->distanceTo[w] > distThruE)
+      {
+         this->distanceTo[w] = distThruE;
+         this->edgeTo[w] = e;
+
+         if (!onQueue[w])
+         {
+            queue.push(w);
+            onQueue[w] = true;
+         }
+
+         if (++nbRelaxations % this->distanceTo.size() == 0)
+            cycle = this->edgeToCycle(source);
+      }
+   }
+
+public:
+
+   /**
+    * @brief Constructeur à partir du graphe g et du sommet v à la source
+    *        des plus courts chemins.
+    * @param g Graphe où calculer les plus courts chemins.
+    * @param v Numéro du sommet source.
     */
-   int checkAccessToSource (int i)
+   BellmanFordQueueSP (const GraphType &g, int v) : onQueue(g.V(), false), nbRelaxations(0), source(v)
    {
-      std::vector<bool> marked;
-      marked.resize(isVerified.size());
-      std::fill_n(marked.begin(), marked.size(), false);
+      this->edgeTo.resize(g.V());
+      this->distanceTo.assign(g.V(), std::numeric_limits<Weight>::max());
 
-      Edge e = BASE::edgeTo[i];
+      this->edgeTo[v] = Edge(v, v, 0);
+      this->distanceTo[v] = 0;
 
-      // Temps qu'on ne recontre pas un sommet déjà traité.
-      while (!isVerified[e.From()])
+      queue.push(v);
+      onQueue[v] = true;
+
+      while (!queue.empty() && cycle.empty())
       {
-         isVerified[e.From()] = true;
-         marked[e.From()] = true;
-         e = BASE::edgeTo[e.From()];
+         int u = queue.front();
+         queue.pop();
+         onQueue[u] = false;
+
+         g.forEachAdjacentEdge(u, [this] (const Edge &e)
+         {
+            this->relax(e);
+         });
       }
+   }
 
-      // Si marked, une boucle est détectée, sinon on a atteint
-      // une branche de l'arbre qui à accès à la source
-      return marked[e.From()] ? e.From() : source;
+   /**
+    * @brief Indique si un circuit absorbant est accessible depuis la source.
+    * @details Dans ce cas, distanceTo et edgeTo ne sont pas des plus courts chemins.
+    */
+   bool hasNegativeCycle () const
+   {
+      return !cycle.empty();
    }
 
    /**
-    * @brief Calcule les arcs formant une boucle. i est un sommet de la boucle.
-    * @param i Sommet issu de la boucle.
-    * @return Liste des arcs formant la boucle.
-    * @details Si i n'appartient pas à une boucle, retourne une liste vide.
+    * @brief Renvoie les arcs du circuit absorbant dans l'ordre de parcours,
+    *        ou une liste vide s'il n'y en a pas.
     */
-   std::list<Edge> getLoop (int i)
+   const std::list<Edge> &NegativeCycle () const
+   {
+      return cycle;
+   }
+};
+
+/**
+ * @brief Algorithme de BellmanFord parallèle, par frontières.
+ * @tparam GraphType Type du graphe pondéré orienté à traiter.
+ * @details GraphType doit se comporter comme un GraphWeightedDirected et
+ *          définir V() et forEachAdjacentEdge(int, Func), ainsi que le type
+ *          GraphType::Edge. Ce dernier doit se comporter comme
+ *          EdgeWeightedDirected, c-a-d définir From(), To() et Weight().
+ *
+ *          Le calcul procède par tours. À chaque tour, seuls les arcs sortant
+ *          de la frontière, c-a-d des sommets dont la distance a diminué au
+ *          tour précédent, sont relâchés. La frontière est répartie entre les
+ *          threads, qui la traitent en deux phases séparées par une barrière:
+ *          - chaque arc u->w propose distanceTo[u] + poids comme distance de
+ *            w, le minimum des propositions est retenu de manière atomique;
+ *          - les arcs dont la proposition égale ce minimum se disputent w par
+ *            compare-and-swap. Seul le gagnant écrit edgeTo[w] et place w
+ *            dans la frontière suivante.
+ *          distanceTo n'est mis à jour qu'à la fin du tour, si bien que les
+ *          distances obtenues ne dépendent pas du nombre de threads.
+ *
+ *          Le calcul s'arrête dès qu'un tour ne change plus rien. Comme dans
+ *          BellmanFordQueueSP, tous les V relâchements réussis, on cherche un
+ *          cycle dans le graphe des edgeTo. Une frontière encore non vide
+ *          après V tours prouve qu'un circuit absorbant est accessible, mais
+ *          pas que le graphe des edgeTo le contienne déjà: on le recherche
+ *          donc à chaque tour suivant, jusqu'à ce qu'il y apparaisse.
+ */
+template<typename GraphType>
+class ParallelBellmanFordSP : public ShortestPath<GraphType>
+{
+   typedef ShortestPath<GraphType> BASE;
+   typedef typename BASE::Edge Edge;
+   typedef typename BASE::Weight Weight;
+
+   // Circuit absorbant trouvé, vide s'il n'y en a pas.
+   std::list<Edge> cycle;
+
+   // Remplace a par value si value est plus petit.
+   static void atomicMin (std::atomic<Weight> &a, Weight value)
+   {
+      Weight current = a.load(std::memory_order_relaxed);
+      while (value < current && !a.compare_exchange_weak(current, value, std::memory_order_relaxed));
+   }
+
+public:
+
+   /**
+    * @brief Constructeur à partir du graphe g et du sommet v à la source
+    *        des plus courts chemins.
+    * @param g Graphe où calculer les plus courts chemins.
+    * @param v Numéro du sommet source.
+    * @param nbThreads Nombre de threads, 0 pour utiliser tous les coeurs.
+    */
+   ParallelBellmanFordSP (const GraphType &g, int v, unsigned nbThreads = 0)
+   {
+      const int V = g.V();
+      this->edgeTo.resize(V);
+      this->distanceTo.assign(V, std::numeric_limits<Weight>::max());
+
+      this->edgeTo[v] = Edge(v, v, 0);
+      this->distanceTo[v] = 0;
+
+      // Plus petite distance proposée pour chaque sommet depuis le début
+      std::vector<std::atomic<Weight>> proposed(V);
+
+      // Dernier tour où chaque sommet a été attribué à un arc
+      std::vector<std::atomic<int>> claimedIn(V);
+
+      for (int w = 0; w < V; ++w)
+      {
+         proposed[w].store(this->distanceTo[w], std::memory_order_relaxed);
+         claimedIn[w].store(0, std::memory_order_relaxed);
+      }
+
+      const unsigned T = threadCount(nbThreads);
+      std::vector<int> frontier(1, v);
+      std::vector<std::vector<int>> next(T);
+
+      int round = 1;
+      long long nbRelaxations = 0;
+      bool done = false;
+
+      Barrier barrier(T);
+      parallelFor(T, int(T), [&] (unsigned t, int, int)
+      {
+         while (!done)
+         {
+            size_t begin = frontier.size() * t / T;
+            size_t end   = frontier.size() * (t + 1) / T;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+               Weight du = this->distanceTo[frontier[i]];
+               g.forEachAdjacentEdge(frontier[i], [&] (const Edge &e)
+               {
+                  atomicMin(proposed[e.To()], du + e.Weight());
+               });
+            }
+            barrier.wait();
+
+            for (size_t i = begin; i < end; ++i)
+            {
+               Weight du = this->distanceTo[frontier[i]];
+               g.forEachAdjacentEdge(frontier[i], [&] (const Edge &e)
+               {
+                  int w = e.To();
+                  Weight d = du + e.Weight();
+                  if (d >= this->distanceTo[w] || d != proposed[w].load(std::memory_order_relaxed))
+                     return;
+
+                  int last = claimedIn[w].load(std::memory_order_relaxed);
+                  if (last != round && claimedIn[w].compare_exchange_strong(last, round, std::memory_order_relaxed))
+                  {
+                     this->edgeTo[w] = e;
+                     next[t].push_back(w);
+                  }
+               });
+            }
+            barrier.wait();
+
+            if (t == 0)
+            {
+               frontier.clear();
+               for (std::vector<int> &part : next)
+               {
+                  frontier.insert(frontier.end(), part.begin(), part.end());
+                  part.clear();
+               }
+
+               for (int w : frontier)
+                  this->distanceTo[w] = proposed[w].load(std::memory_order_relaxed);
+
+               long long before = nbRelaxations;
+               nbRelaxations += frontier.size();
+               if (!frontier.empty() && (round >= V || nbRelaxations / V != before / V))
+                  cycle = this->edgeToCycle(v);
+
+               ++round;
+               done = frontier.empty() || !cycle.empty();
+            }
+            barrier.wait();
+         }
+      });
+   }
+
+   /**
+    * @brief Indique si un circuit absorbant est accessible depuis la source.
+    * @details Dans ce cas, distanceTo et edgeTo ne sont pas des plus courts chemins.
+    */
+   bool hasNegativeCycle () const
+   {
+      return !cycle.empty();
+   }
+
+   /**
+    * @brief Renvoie les arcs du circuit absorbant dans l'ordre de parcours,
+    *        ou une liste vide s'il n'y en a pas.
+    */
+   const std::list<Edge> &NegativeCycle () const
+   {
+      return cycle;
+   }
+};
+
+/**
+ * @brief Vérifie si le graphe contient un circuit à coût négatif accessible
+ *        depuis la source.
+ * @tparam GraphType Type du graphe pondéré orienté à traiter.
+ * @details GraphType doit se comporter comme un GraphWeightedDirected et
+ *          définir V() et forEachAdjacentEdge(int, Func), ainsi que le type
+ *          GraphType::Edge. Ce dernier doit se comporter comme
+ *          EdgeWeightedDirected, c-a-d définir From(), To() et Weight().
+ *
+ *          Bellman-Ford à base de file avec démontage de sous-arbres (Tarjan).
+ *          L'arbre des edgeTo est tenu à jour sous forme de liste en ordre
+ *          préfixe. Quand la distance de w diminue, son sous-arbre est retiré
+ *          de l'arbre: les distances de ses descendants sont périmées, ils
+ *          sortent de la file jusqu'à ce qu'ils soient à nouveau atteints. Si
+ *          l'arc relâché part d'un sommet de ce sous-arbre, il ferme un cycle
+ *          de edgeTo, donc un circuit absorbant, détecté dès sa formation.
+ */
+template<typename GraphType>
+class BellmanFordCycleDetection : public ShortestPath<GraphType>
+{
+
+private:
+   typedef ShortestPath<GraphType> BASE;
+   typedef typename BASE::Edge Edge;
+   typedef typename BASE::Weight Weight;
+
+   // Arbre des plus courts chemins en ordre préfixe: chaque sommet est suivi
+   // de ses descendants, tous de profondeur supérieure à la sienne. La case
+   // V sert de racine fictive quand tous les sommets sont source.
+   std::vector<int> next, prev;
+   std::vector<int> depth;
+   std::vector<bool> inTree;
+
+   std::queue<int> queue;
+   std::vector<bool> onQueue;
+
+   /**
+    * @brief Retire de l'arbre les descendants de w, et w lui-même.
+    * @param from Origine de l'arc qui va rattacher w.
+    * @return Vrai si from est un descendant de w, c-a-d si l'arc ferme un cycle.
+    */
+   bool detachSubtree (int w, int from)
+   {
+      int last = w;
+      for (int x = next[w]; x != -1 && depth[x] > depth[w]; x = next[x])
+      {
+         if (x == from) return true;
+         inTree[x] = false;
+         onQueue[x] = false;
+         last = x;
+      }
+
+      // On retire le bloc w..last de la liste
+      next[prev[w]] = next[last];
+      if (next[last] != -1) prev[next[last]] = prev[w];
+      next[last] = -1;
+      return false;
+   }
+
+   // Insère w juste après son nouveau parent v
+   void attach (int w, int v)
+   {
+      prev[w] = v;
+      next[w] = next[v];
+      if (next[v] != -1) prev[next[v]] = w;
+      next[v] = w;
+      depth[w] = depth[v] + 1;
+      inTree[w] = true;
+   }
+
+   /**
+    * @brief Construit la liste des arcs du cycle fermé par e.
+    * @details Le cycle suit les edgeTo de e.To() jusqu'à e.From(), puis e.
+    */
+   std::list<Edge> getLoop (const Edge &e)
    {
       std::list<Edge> loop;
-      Edge e = BASE::edgeTo[i];
+      loop.push_front(e);
+      for (int v = e.From(); v != e.To(); v = this->edgeTo[v].From())
+         loop.push_front(this->edgeTo[v]);
+      return loop;
+   }
+
+   /**
+    * @brief Relâche l'arc e.
+    * @Throws GraphNegativeDirectedCycleException si e ferme un circuit absorbant.
+    */
+   void relax (const Edge &e)
+   {
+      int v = e.From(), w = e.To();
+      Weight distThruE = this->distanceTo[v] + e.Weight();
+
+      if (this->distanceTo[w] <= distThruE) return;
+
+      if (v == w || (inTree[w] && detachSubtree(w, v)))
+         throw GraphNegativeDirectedCycleException(getLoop(e));
+
+      this->distanceTo[w] = distThruE;
+      this->edgeTo[w] = e;
+      attach(w, v);
 
-      while (e.From() != i)
+      if (!onQueue[w])
       {
-         loop.push_back(e);
-         e = BASE::edgeTo[e.From()];
+         queue.push(w);
+         onQueue[w] = true;
       }
+   }
 
-      loop.push_back(e);
+   // Relâche les arcs sortants des sommets de la file jusqu'à ce qu'elle soit vide
+   void run (const GraphType &g)
+   {
+      while (!queue.empty())
+      {
+         int u = queue.front();
+         queue.pop();
 
-      std::reverse(loop.begin(), loop.end());
+         // u a pu sortir de la file en même temps que son sous-arbre
+         if (!onQueue[u]) continue;
+         onQueue[u] = false;
 
-      return e.From() == source ? std::list<Edge>() : loop;
+         g.forEachAdjacentEdge(u, [this] (const Edge &e)
+         {
+            this->relax(e);
+         });
+      }
    }
 
 public:
@@ -191,25 +570,52 @@ public:
     * @Throws Lance une GraphNegativeDirectedCycleException en cas de circuit à
     *         coût négatif.
     */
-   BellmanFordCycleDetection (const GraphType &g, int v) : BASE(g, v), source(v)
+   BellmanFordCycleDetection (const GraphType &g, int v)
+           : next(g.V() + 1, -1), prev(g.V() + 1, -1), depth(g.V() + 1, 0),
+             inTree(g.V() + 1, false), onQueue(g.V() + 1, false)
+   {
+      this->edgeTo.resize(g.V());
+      this->distanceTo.assign(g.V(), std::numeric_limits<Weight>::max());
+
+      this->edgeTo[v] = Edge(v, v, 0);
+      this->distanceTo[v] = 0;
+      inTree[v] = true;
+
+      queue.push(v);
+      onQueue[v] = true;
+
+      run(g);
+   }
+
+   /**
+    * @brief Constructeur à partir du graphe g, tous les sommets étant source.
+    * @details Équivaut à ajouter une source fictive reliée à chaque sommet par
+    *          un arc de poids nul. distanceTo est alors un potentiel réalisable:
+    *          distanceTo[w] <= distanceTo[v] + poids(v->w) pour tout arc.
+    * @Throws Lance une GraphNegativeDirectedCycleException si le graphe contient
+    *         un circuit à coût négatif, où qu'il soit.
+    */
+   explicit BellmanFordCycleDetection (const GraphType &g)
+           : next(g.V() + 1, -1), prev(g.V() + 1, -1), depth(g.V() + 1, 1),
+             inTree(g.V() + 1, true), onQueue(g.V() + 1, true)
    {
-      isVerified.resize(g.V());
-      std::fill_n(isVerified.begin(), isVerified.size(), false);
-      isVerified[source] = true;
+      int root = g.V();
+      this->edgeTo.resize(g.V());
+      this->distanceTo.assign(g.V(), 0);
 
-      // Vérifie si chaque sommet peut atteindre la source
-      g.forEachVertex([&] (int s)
+      // Tous les sommets sont fils de la racine fictive
+      depth[root] = 0;
+      int last = root;
+      for (int v = 0; v < g.V(); ++v)
       {
-         if (!isVerified[s])
-         {
-            int vReached = checkAccessToSource(s);
-            if (vReached != source)
-            {
-               throw GraphNegativeDirectedCycleException(getLoop(vReached));
-            }
-         }
-      });
+         this->edgeTo[v] = Edge(v, v, 0);
+         next[last] = v;
+         prev[v] = last;
+         last = v;
+         queue.push(v);
+      }
 
+      run(g);
    }
 
    /**
@@ -239,4 +645,184 @@ public:
    };
 };
 
+/**
+ * @brief Détection incrémentale de circuit absorbant dans un graphe dont les
+ *        poids changent.
+ * @tparam GraphType Type du graphe pondéré orienté à traiter.
+ * @details GraphType doit se comporter comme un GraphWeightedDirected et
+ *          définir V() et forEachAdjacentEdge(int, Func), ainsi que le type
+ *          GraphType::Edge.
+ *
+ *          On maintient un potentiel p réalisable: p[w] <= p[v] + poids(v->w)
+ *          pour tout arc, ce qui équivaut à l'absence de circuit absorbant.
+ *          Augmenter un poids ne peut pas rendre p irréalisable. Quand un arc
+ *          u->v devient trop court, on lance Dijkstra depuis v sur les coûts
+ *          réduits poids(x->y) + p[x] - p[y] >= 0, limité aux sommets plus
+ *          proches que le déficit de u->v. Si u est atteint, u->v ferme un
+ *          circuit absorbant. Sinon, on corrige p sur les seuls sommets visités.
+ *
+ *          Le graphe est gardé par référence: après chaque modification d'un
+ *          poids, appeler update avec les extrémités de l'arc modifié.
+ */
+template<typename GraphType>
+class IncrementalCycleDetection
+{
+public:
+   typedef typename ShortestPath<GraphType>::Edge Edge;
+   typedef typename ShortestPath<GraphType>::Weight Weight;
+
+private:
+   typedef std::pair<Weight, int> WeightVertex;
+
+   const GraphType &g;
+
+   // Potentiel réalisable, valide seulement en l'absence de circuit
+   std::vector<Weight> potential;
+
+   // Circuit absorbant trouvé, vide s'il n'y en a pas
+   std::list<Edge> cycle;
+
+   // Espace de travail de Dijkstra, remis à zéro sur les seules cases touchées
+   std::vector<Weight> dist;
+   std::vector<Edge> edgeTo;
+   std::vector<int> touched;
+
+   static Weight infinity ()
+   {
+      return std::numeric_limits<Weight>::max();
+   }
+
+   // Recalcule le potentiel sur tout le graphe
+   void rebuild ()
+   {
+      cycle.clear();
+      try
+      {
+         BellmanFordCycleDetection<GraphType> bf(g);
+         for (int v = 0; v < g.V(); ++v)
+            potential[v] = bf.distanceToVertex(v);
+      }
+      catch (const typename BellmanFordCycleDetection<GraphType>::GraphNegativeDirectedCycleException &e)
+      {
+         cycle = e.Cycle();
+      }
+   }
+
+   // Poids du plus court arc u->v, infini s'il n'y en a pas
+   Weight arcWeight (int u, int v) const
+   {
+      Weight w = infinity();
+      g.forEachAdjacentEdge(u, [&] (const Edge &e)
+      {
+         if (e.To() == v && e.Weight() < w) w = e.Weight();
+      });
+      return w;
+   }
+
+public:
+
+   /**
+    * @brief Constructeur à partir du graphe g, qui est analysé en entier.
+    */
+   explicit IncrementalCycleDetection (const GraphType &g)
+           : g(g), potential(g.V(), 0), dist(g.V(), infinity()), edgeTo(g.V())
+   {
+      rebuild();
+   }
+
+   /**
+    * @brief Prend en compte la modification du poids de l'arc u->v.
+    * @return Vrai s'il n'y a pas de circuit absorbant après la modification.
+    * @details Si un circuit était connu, tout le graphe est réanalysé puisque
+    *          le potentiel n'est alors plus valide.
+    */
+   bool update (int u, int v)
+   {
+      if (!cycle.empty())
+      {
+         rebuild();
+         return cycle.empty();
+      }
+
+      Weight weight = arcWeight(u, v);
+      if (weight == infinity()) return true;
+
+      // Déficit de l'arc u->v vis-à-vis du potentiel
+      Weight delta = potential[v] - (potential[u] + weight);
+      if (delta <= 0) return true;
+
+      for (int x : touched) dist[x] = infinity();
+      touched.clear();
+
+      std::priority_queue<WeightVertex, std::vector<WeightVertex>, std::greater<WeightVertex>> pq;
+      std::vector<int> settled;
+
+      dist[v] = 0;
+      touched.push_back(v);
+      pq.push(WeightVertex(0, v));
+
+      while (!pq.empty() && pq.top().first < delta)
+      {
+         WeightVertex top = pq.top();
+         pq.pop();
+         int x = top.second;
+         if (top.first > dist[x]) continue;   // entrée périmée
+
+         if (x == u)
+         {
+            // chemin v -> ... -> u plus court que le déficit: circuit absorbant
+            cycle.push_front(Edge(u, v, weight));
+            for (int y = u; y != v; y = edgeTo[y].From())
+               cycle.push_front(edgeTo[y]);
+            return false;
+         }
+         settled.push_back(x);
+
+         g.forEachAdjacentEdge(x, [&] (const Edge &e)
+         {
+            int y = e.To();
+            Weight reduced = std::max(Weight(0), e.Weight() + potential[x] - potential[y]);
+            Weight d = top.first + reduced;
+            if (d < dist[y])
+            {
+               if (dist[y] == infinity()) touched.push_back(y);
+               dist[y] = d;
+               edgeTo[y] = e;
+               pq.push(WeightVertex(d, y));
+            }
+         });
+      }
+
+      for (int x : settled)
+         potential[x] -= delta - dist[x];
+
+      return true;
+   }
+
+   /**
+    * @brief Indique si le graphe contient un circuit absorbant.
+    */
+   bool hasNegativeCycle () const
+   {
+      return !cycle.empty();
+   }
+
+   /**
+    * @brief Arcs du circuit absorbant dans l'ordre de parcours, ou une liste
+    *        vide s'il n'y en a pas.
+    */
+   const std::list<Edge> &Cycle () const
+   {
+      return cycle;
+   }
+
+   /**
+    * @brief Potentiel du sommet v, valide s'il n'y a pas de circuit absorbant.
+    */
+   Weight potentialOf (int v) const
+   {
+      return potential.at(v);
+   }
+};
+
 #endif
@@ -14,9 +14,12 @@
 #include <sstream>
 #include <algorithm>
 #include <vector>
-#include <map>
 #include <functional>
+#include <iterator>
+#include <cstring>
+#include <stdexcept>
 
+#include "SymbolTable.h"
 #include "Util.h"
 
 template<typename GraphType>
@@ -25,8 +28,10 @@ class SymbolGraphWeightedDirected {
 private:
     Graph* g;
 
-    std::map<std::string, int> symbolTable;
-    std::vector<std::string> keys;
+    SymbolTable symbols;
+
+    // conversion d'un taux en poids d'arc
+    std::function<double(double)> cost;
 
 public:
 
@@ -35,50 +40,72 @@ public:
     }
 
     //creation du SymbolGraph a partir du fichier movies.txt
-    SymbolGraphWeightedDirected(const std::string& filename, const std::function<double(double)>& costFunction, char delim = '/') {
-        std::string line;
-
-        std::ifstream s(filename);
-        int cnt = 0;
+    //chaque ligne est de la forme "from<delim>to<delim>taux". Le fichier est
+    //lu une seule fois: les symboles sont numerotes au fil de la lecture et
+    //les arcs mis de cote jusqu'a ce que le nombre de sommets soit connu.
+    SymbolGraphWeightedDirected(const std::string& filename, const std::function<double(double)>& costFunction, char delim = '/')
+            : cost(costFunction) {
+        std::ifstream s(filename, std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(s)), std::istreambuf_iterator<char>());
+        s.close();
 
-        while (std::getline(s, line)) {
-            auto names = split(line, delim);
-            if (!contains(names[0])) {
-                symbolTable[names[0]] = cnt++;
-            }
-            if (!contains(names[1])) {
-                symbolTable[names[1]] = cnt++;
+        struct Rate {
+            int from, to;
+            double rate;
+        };
+        std::vector<Rate> rates;
+
+        const char* p = content.data();
+        const char* end = p + content.size();
+        while (p < end) {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (eol == nullptr) eol = end;
+            const char* next = eol + (eol != end);
+            if (eol != p && eol[-1] == '\r') --eol;
+
+            if (eol != p) {
+                Tokenizer tokenizer(p, eol, delim);
+                StringToken from, to, rate;
+                Rate r;
+                if (!tokenizer.next(from) || !tokenizer.next(to) || !tokenizer.next(rate)
+                    || !parseDouble(rate, r.rate))
+                    throw std::runtime_error("SymbolGraphWeightedDirected : ligne invalide dans " + filename);
+
+                r.from = symbols.intern(from.data, from.size);
+                r.to = symbols.intern(to.data, to.size);
+                rates.push_back(r);
             }
+            p = next;
         }
-        s.close();
 
-        keys.resize(cnt);
-        for (const auto& pair : symbolTable)
-            keys[pair.second] = pair.first;
-
-        g = new Graph(cnt);
+        g = new Graph(symbols.size());
+        for (const Rate& r : rates)
+            g->addEdge(r.from, r.to, costFunction(r.rate));
+    }
 
-        s.open(filename);
-        while (std::getline(s, line)) {
-            auto names = split(line, delim);
-            g->addEdge(index(names[0]), index(names[1]), costFunction(std::stod(names[2])));
-        }
-        s.close();
+    //modifie le taux de from vers to, l'arc est cree s'il n'existe pas.
+    //lance std::out_of_range si l'un des symboles est inconnu
+    void updateRate(const std::string& from, const std::string& to, double rate) {
+        g->setEdgeWeight(index(from), index(to), cost(rate));
     }
 
     //verifie la presence d'un symbole
     bool contains(const std::string& name) const {
-        return symbolTable.find(name) != symbolTable.end();
+        return symbols.find(name) != -1;
     }
 
     //index du sommet correspondant au symbole
+    //lance std::out_of_range si le symbole est inconnu
     int index(const std::string& name) const {
-        return symbolTable.at(name);
+        int idx = symbols.find(name);
+        if (idx == -1)
+            throw std::out_of_range("SymbolGraphWeightedDirected : symbole inconnu " + name);
+        return idx;
     }
 
     //symbole correspondant au sommet
     std::string symbol(int idx) const {
-        return keys[idx];
+        return symbols.name(idx);
     }
 
     //symboles adjacents a un symbole
@@ -0,0 +1,118 @@
+/*
+ * File:   SymbolTable.h
+ * Author: Berney Alec, Forestier Quentin, Herzig Melvyn
+ *
+ * Created on 17. octobre 2026
+ */
+
+#ifndef ASD2_SymbolTable_h
+#define ASD2_SymbolTable_h
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Table de symboles associant à chaque nom un numéro, dans l'ordre
+ *        de première apparition.
+ * @details Les noms sont copiés bout à bout dans une seule zone mémoire.
+ *          L'index est une table de hachage à adressage ouvert (sondage
+ *          linéaire) dont la taille est une puissance de 2, doublée dès
+ *          qu'elle est à moitié pleine. Une recherche ne fait aucune allocation.
+ */
+class SymbolTable
+{
+private:
+   // Noms concaténés; le nom i occupe [offsets[i], offsets[i + 1])
+   std::vector<char> arena;
+   std::vector<size_t> offsets;
+
+   // Cases de l'index: numéro du symbole + 1, 0 si la case est vide
+   std::vector<int> slots;
+
+   // Hachage FNV-1a
+   static size_t hash (const char *p, size_t n)
+   {
+      size_t h = 2166136261u;
+      for (size_t i = 0; i < n; ++i)
+      {
+         h ^= (unsigned char) p[i];
+         h *= 16777619u;
+      }
+      return h;
+   }
+
+   bool equals (int id, const char *p, size_t n) const
+   {
+      return offsets[id + 1] - offsets[id] == n && std::memcmp(arena.data() + offsets[id], p, n) == 0;
+   }
+
+   // Case contenant le nom p, ou case vide où l'insérer
+   size_t slotOf (const char *p, size_t n) const
+   {
+      size_t mask = slots.size() - 1;
+      size_t i = hash(p, n) & mask;
+      while (slots[i] != 0 && !equals(slots[i] - 1, p, n))
+         i = (i + 1) & mask;
+      return i;
+   }
+
+   void grow ()
+   {
+      std::vector<int> old(slots.size() * 2, 0);
+      old.swap(slots);
+      for (int id = 0; id < size(); ++id)
+         slots[slotOf(arena.data() + offsets[id], offsets[id + 1] - offsets[id])] = id + 1;
+   }
+
+public:
+
+   SymbolTable () : offsets(1, 0), slots(16, 0)
+   {}
+
+   // Nombre de symboles
+   int size () const
+   {
+      return int(offsets.size()) - 1;
+   }
+
+   // Numéro du nom [p, p + n), ajouté à la table s'il est nouveau
+   int intern (const char *p, size_t n)
+   {
+      size_t i = slotOf(p, n);
+      if (slots[i] != 0) return slots[i] - 1;
+
+      int id = size();
+      arena.insert(arena.end(), p, p + n);
+      offsets.push_back(arena.size());
+      slots[i] = id + 1;
+
+      if (2 * size_t(size()) >= slots.size()) grow();
+      return id;
+   }
+
+   int intern (const std::string &name)
+   {
+      return intern(name.data(), name.size());
+   }
+
+   // Numéro du nom [p, p + n), -1 s'il est absent
+   int find (const char *p, size_t n) const
+   {
+      size_t i = slotOf(p, n);
+      return slots[i] - 1;
+   }
+
+   int find (const std::string &name) const
+   {
+      return find(name.data(), name.size());
+   }
+
+   // Nom du symbole id
+   std::string name (int id) const
+   {
+      return std::string(arena.begin() + offsets[id], arena.begin() + offsets[id + 1]);
+   }
+};
+
+#endif
@@ -1,18 +1,57 @@
-
 #include "Util.h"
-#include <sstream>
-
-std::vector<std::string> &split(const std::string &s, char delim, std::vector<std::string> &elems) {
-	std::stringstream ss(s);
-	std::string item;
-	while (std::getline(ss, item, delim)) {
-		elems.push_back(item);
-	}
-	return elems;
+#include <algorithm>
+#include <cstdlib>
+
+Tokenizer::Tokenizer(const char* begin, const char* end, char delim)
+	: pos(begin), end(end), delim(delim) {}
+
+Tokenizer::Tokenizer(const std::string& line, char delim)
+	: Tokenizer(line.data(), line.data() + line.size(), delim) {}
+
+bool Tokenizer::next(StringToken& token) {
+	if (pos == end)
+		return false;
+	const char* stop = std::find(pos, end, delim);
+	token.data = pos;
+	token.size = size_t(stop - pos);
+	pos = stop == end ? end : stop + 1;
+	return true;
+}
+
+// Saute les blancs de tete, comme std::stoi et std::stod
+static const char* skipSpaces(const StringToken& token) {
+	const char* p = token.data;
+	const char* end = token.data + token.size;
+	while (p != end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+		++p;
+	return p;
 }
 
-std::vector<std::string> split(const std::string &s, char delim) {
-	std::vector<std::string> elems;
-	split(s, delim, elems);
-	return elems;
+bool parseInt(const StringToken& token, int& value) {
+	const char* p = skipSpaces(token);
+	const char* end = token.data + token.size;
+
+	bool negative = p != end && *p == '-';
+	if (p != end && (*p == '-' || *p == '+')) ++p;
+	if (p == end || *p < '0' || *p > '9') return false;
+
+	long long v = 0;
+	while (p != end && *p >= '0' && *p <= '9')
+		v = v * 10 + (*p++ - '0');
+	value = int(negative ? -v : v);
+	return true;
+}
+
+bool parseDouble(const StringToken& token, double& value) {
+	// strtod attend une chaine terminee par un zero: le champ est recopie
+	// dans un tampon local
+	const char* p = skipSpaces(token);
+	char buffer[64];
+	size_t n = std::min(size_t(token.data + token.size - p), sizeof(buffer) - 1);
+	std::copy(p, p + n, buffer);
+	buffer[n] = '\0';
+
+	char* last;
+	value = std::strtod(buffer, &last);
+	return last != buffer;
 }
@@ -12,6 +12,8 @@
 #include "SymbolGraphWeightedDirected.h"
 #include "ShortestPath.h"
 #include "GraphWeightedDirected.h"
+#include "CycleEnumeration.h"
+#include "MinimumMeanCycle.h"
 
 using namespace std;
 using costFunction = const std::function<double (double)>;
@@ -39,6 +41,166 @@ void afficherCircuit (const std::list<Edge> &loop, const SymbolGraphe &sg)
    cout << result << " " << sg.symbol(loop.back().To()) << endl;
 }
 
+/**
+ * @brief Indique si g contient un circuit absorbant, selon la détection de
+ *        BellmanFord lancée depuis tous les sommets.
+ */
+template<typename Graph>
+bool contientCircuitAbsorbant (const Graph &g)
+{
+   try
+   {
+      BellmanFordCycleDetection<Graph> bfcd(g);
+   }
+   catch (const typename BellmanFordCycleDetection<Graph>::GraphNegativeDirectedCycleException&)
+   {
+      return true;
+   }
+   return false;
+}
+
+/**
+ * @brief Modifie quelques taux du fichier et vérifie après chaque
+ *        modification que la détection incrémentale rend le même verdict que
+ *        BellmanFordCycleDetection. Sans circuit, le potentiel doit rester
+ *        réalisable; avec, le circuit trouvé doit être absorbant.
+ * @param filename Nom du fichier de taux de change.
+ * @param getTaux Fonction de coût appliquée aux taux.
+ * @return Vrai si tous les verdicts concordent.
+ */
+bool testDetectionIncrementale (const string &filename, costFunction &getTaux)
+{
+   typedef GraphWeightedDirected<double> Graph;
+
+   struct Modification
+   {
+      string from, to;
+      double rate;
+   };
+
+   // Baisse d'un taux, hausse sans arbitrage, hausse créant l'arbitrage
+   // USD -> INR -> EUR -> USD, puis retour au taux de reseau.txt
+   const Modification modifications[] = {
+           {"CHF", "USD", 1.05},
+           {"USD", "INR", 74.0},
+           {"USD", "INR", 76.65},
+           {"USD", "INR", 73.65}
+   };
+
+   SymbolGraphWeightedDirected<Graph> symbolGraph(filename, getTaux, ';');
+   const Graph &g = symbolGraph.G();
+   IncrementalCycleDetection<Graph> incremental(g);
+
+   bool ok = incremental.hasNegativeCycle() == contientCircuitAbsorbant(g);
+
+   for (const Modification &m : modifications)
+   {
+      if (!symbolGraph.contains(m.from) || !symbolGraph.contains(m.to)) continue;
+
+      symbolGraph.updateRate(m.from, m.to, m.rate);
+      bool sansCircuit = incremental.update(symbolGraph.index(m.from), symbolGraph.index(m.to));
+
+      if (sansCircuit == contientCircuitAbsorbant(g))
+      {
+         cout << "Verdict different de BellmanFord apres " << m.from << " -> " << m.to << endl;
+         ok = false;
+      }
+
+      if (sansCircuit)
+      {
+         g.forEachEdge([&] (const Graph::Edge &e)
+         {
+            if (incremental.potentialOf(e.From()) + e.Weight() < incremental.potentialOf(e.To()) - 0.000001)
+            {
+               cout << "Potentiel irrealisable sur " << symbolGraph.symbol(e.From()) << " -> "
+                    << symbolGraph.symbol(e.To()) << endl;
+               ok = false;
+            }
+         });
+      }
+      else
+      {
+         double poids = 0;
+         for (const Graph::Edge &e : incremental.Cycle())
+            poids += e.Weight();
+         if (poids >= 0)
+         {
+            cout << "Circuit non absorbant apres " << m.from << " -> " << m.to << endl;
+            ok = false;
+         }
+      }
+   }
+
+   return ok;
+}
+
+/**
+ * @brief Compare, depuis chaque sommet de g, les variantes de BellmanFord à
+ *        la détection de circuit et aux distances de BellmanFordSP.
+ * @details Le circuit absorbant accessible depuis la source doit être signalé
+ *          si et seulement si BellmanFordCycleDetection le trouve. Sans
+ *          circuit, les distances doivent être celles de BellmanFordSP.
+ * @return Vrai si toutes les variantes concordent.
+ */
+template<typename Graph>
+bool testBellmanFord (const Graph &g)
+{
+   bool ok = true;
+
+   for (int s = 0; s < g.V(); ++s)
+   {
+      bool circuit = false;
+      try
+      {
+         BellmanFordCycleDetection<Graph> bfcd(g, s);
+      }
+      catch (const typename BellmanFordCycleDetection<Graph>::GraphNegativeDirectedCycleException&)
+      {
+         circuit = true;
+      }
+
+      BellmanFordSP<Graph> reference(g, s);
+
+      BellmanFordQueueSP<Graph> queue(g, s);
+      if (queue.hasNegativeCycle() != circuit)
+      {
+         cout << "BellmanFordQueueSP : detection differente depuis " << s << endl;
+         ok = false;
+      }
+      else if (!circuit)
+      {
+         for (int v = 0; v < g.V(); ++v)
+            if (fabs(queue.distanceToVertex(v) - reference.distanceToVertex(v)) > 0.000001)
+            {
+               cout << "BellmanFordQueueSP : distance de " << s << " a " << v << " differente" << endl;
+               ok = false;
+            }
+      }
+
+      for (unsigned nbThreads : {1u, 4u})
+      {
+         ParallelBellmanFordSP<Graph> parallel(g, s, nbThreads);
+         if (parallel.hasNegativeCycle() != circuit)
+         {
+            cout << "ParallelBellmanFordSP (" << nbThreads << " threads) : detection differente depuis " << s << endl;
+            ok = false;
+            continue;
+         }
+         if (circuit) continue;
+
+         for (int v = 0; v < g.V(); ++v)
+            if (fabs(parallel.distanceToVertex(v) - reference.distanceToVertex(v)) > 0.000001)
+            {
+               cout << "ParallelBellmanFordSP (" << nbThreads << " threads) : distance de " << s
+                    << " a " << v << " differente" << endl;
+               ok = false;
+            }
+      }
+   }
+
+   return ok;
+}
+
 //ARGS reseau.txt
 //ARGS reseau2.txt
 int main (int argc, const char *argv[])
@@ -66,6 +228,12 @@ int main (int argc, const char *argv[])
       cout << "Fichier " << argv[i] << " :" << endl;
       SymbolGraphWeightedDirected<Graph> symbolGraph(argv[i], getTaux, ';');
 
+      bool incrementaleOk = testDetectionIncrementale(argv[i], getTaux);
+      cout << "Verification de la detection incrementale : " << (incrementaleOk ? "reussie" : "echouee") << endl;
+
+      bool bellmanFordOk = testBellmanFord(symbolGraph.G());
+      cout << "Verification des variantes de BellmanFord : " << (bellmanFordOk ? "reussie" : "echouee") << endl;
+
       try
       {
          BellmanFordCycleDetection<Graph> bfcd(symbolGraph.G(), 0);
@@ -77,6 +245,16 @@ int main (int argc, const char *argv[])
 
          afficherCircuit(e.Cycle(), symbolGraph);
 
+         // Liste de toutes les opportunités, de la plus rentable à la moins rentable
+         const int MAX_CONVERSIONS = 4;
+         cout << "Circuits profitables d'au plus " << MAX_CONVERSIONS << " conversions :" << endl;
+         for (const auto &c : NegativeCycleEnumeration<Graph>::Ranked(symbolGraph.G(), MAX_CONVERSIONS))
+            afficherCircuit(c.edges, symbolGraph);
+
+         MinimumMeanCycle<Graph> meilleur(symbolGraph.G());
+         cout << "Meilleur gain moyen par conversion (x" << exp(-meilleur.Mean()) << ") :" << endl;
+         afficherCircuit(meilleur.Cycle(), symbolGraph);
+
          return EXIT_FAILURE;
       }
 